@@ -2,6 +2,7 @@
 
 #include <escher/clipboard.h>
 #include <ion.h>
+#include <kandinsky/ion_context.h>
 #include <poincare/circuit_breaker_checkpoint.h>
 #include <poincare/exception_checkpoint.h>
 #include <poincare/init.h>
@@ -185,6 +186,9 @@ bool AppsContainer::processEvent(Ion::Events::Event event) {
       updateBatteryState();
       switchToBuiltinApp(usbConnectedAppSnapshot());
       Ion::USB::DFU();
+      // The host may have written the storage
+      Ion::Storage::FileSystem::sharedFileSystem->invalidateMemoization();
+      Ion::Storage::FileSystem::sharedFileSystem->upgradeValueFormat();
       // Update LED when exiting DFU mode
       Ion::LED::updateColorWithPlugAndCharge();
       switchToBuiltinApp(activeSnapshot);
@@ -304,6 +308,9 @@ void AppsContainer::run() {
     homeInterruptOcurred = false;
   } else {
     homeInterruptOcurred = true;
+    /* The interrupt may have left Window::redraw before it stopped recording
+     * the uniform fills. */
+    KDIonContext::SharedContext->stopRecording();
   }
 
   ExceptionCheckpoint exceptionCheckpoint;
@@ -329,6 +336,8 @@ void AppsContainer::run() {
       switchToBuiltinApp(initialAppSnapshot());
     }
   } else {
+    // Same as above, the exception may have been raised during a redraw.
+    KDIonContext::SharedContext->stopRecording();
     /* We lock the Poincare pool until the application is destroyed (the pool
      * is then asserted empty). This prevents from allocating new handles
      * with the same identifiers as potential dangling handles (that have
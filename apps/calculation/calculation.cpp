@@ -43,12 +43,9 @@ bool Calculation::operator==(const Calculation &c) {
 }
 
 Calculation *Calculation::next() const {
-  const char *result =
-      reinterpret_cast<const char *>(this) + sizeof(Calculation);
-  for (int i = 0; i < k_numberOfExpressions; i++) {
-    // Pass inputText, exactOutputText, ApproximateOutputText x2
-    result = result + strlen(result) + 1;
-  }
+  // Pass the trees that follow the texts
+  TreeSize size;
+  const char *result = treeAtIndex(k_numberOfExpressions - 1, &size) + size;
   return reinterpret_cast<Calculation *>(const_cast<char *>(result));
 }
 
@@ -64,16 +61,14 @@ const char *Calculation::approximateOutputText(
          strlen(approximateOutputTextWithMaxNumberOfDigits) + 1;
 }
 
-Expression Calculation::input() {
-  return Expression::Parse(m_inputText, nullptr);
-}
+Expression Calculation::input() { return expressionAtIndex(0); }
 
 Expression Calculation::exactOutput() {
   /* Because the angle unit might have changed, we do not simplify again. We
    * thereby avoid turning cos(Pi/4) into sqrt(2)/2 and displaying
    * 'sqrt(2)/2 = 0.999906' (which is totally wrong) instead of
    * 'cos(pi/4) = 0.999906' (which is true in degree). */
-  return Expression::Parse(exactOutputText(), nullptr);
+  return expressionAtIndex(1);
 }
 
 Expression Calculation::approximateOutput(
@@ -109,8 +104,39 @@ Expression Calculation::approximateOutput(
    *
    */
   // clang-format on
-  return Expression::Parse(approximateOutputText(numberOfSignificantDigits),
-                           nullptr);
+  return expressionAtIndex(
+      numberOfSignificantDigits == NumberOfSignificantDigits::Maximal ? 2 : 3);
+}
+
+const char *Calculation::textAtIndex(int index) const {
+  assert(0 <= index && index < k_numberOfExpressions);
+  const char *result = m_inputText;
+  for (int i = 0; i < index; i++) {
+    result = result + strlen(result) + 1;
+  }
+  return result;
+}
+
+const char *Calculation::treeAtIndex(int index, TreeSize *size) const {
+  assert(0 <= index && index < k_numberOfExpressions);
+  // Pass inputText, exactOutputText, ApproximateOutputText x2
+  const char *result = textAtIndex(k_numberOfExpressions - 1);
+  result = result + strlen(result) + 1;
+  for (int i = 0; i < index; i++) {
+    memcpy(size, result, sizeof(TreeSize));
+    result += sizeof(TreeSize) + *size;
+  }
+  memcpy(size, result, sizeof(TreeSize));
+  return result + sizeof(TreeSize);
+}
+
+Expression Calculation::expressionAtIndex(int index) const {
+  TreeSize size;
+  const char *tree = treeAtIndex(index, &size);
+  if (size == 0) {
+    return Expression::Parse(textAtIndex(index), nullptr);
+  }
+  return Expression::ExpressionFromAddress(tree, size);
 }
 
 Layout Calculation::createInputLayout() {
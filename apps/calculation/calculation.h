@@ -18,6 +18,15 @@ class CalculationStore;
  *                                                                                               with maximal           with displayed
  *                                                                                            significant digits      significant digits
  *
+ * followed by, for each of the four texts, the size of the expression tree
+ * parsed from it and the image of this tree. Copying the image in the pool is
+ * much cheaper than parsing the text again each time the history is laid out.
+ * A size of 0 means the tree could not be stored and the text has to be
+ * parsed.
+ *  | TreeSize |   ...   |   ...   | TreeSize |   ...   |
+ *  |   size   |  tree   |   ...   |   size   |  tree   |
+ *      input tree                   approximate output tree 2
+ *
  * */
 // clang-format on
 
@@ -26,6 +35,8 @@ class Calculation {
 
  public:
   constexpr static int k_numberOfExpressions = 4;
+  // Tree images are read from and written to unaligned addresses with memcpy
+  using TreeSize = uint16_t;
   enum class EqualSign : uint8_t { Unknown, Approximation, Equal };
 
   enum class DisplayOutput : uint8_t {
@@ -64,7 +75,8 @@ class Calculation {
    * sufficient free space. */
   constexpr static int k_minimalSize =
       sizeof(uint8_t) + 2 * sizeof(KDCoordinate) + sizeof(uint8_t) +
-      k_numberOfExpressions * Constant::MaxSerializedExpressionSize;
+      k_numberOfExpressions *
+          (Constant::MaxSerializedExpressionSize + sizeof(TreeSize));
 
   Calculation()
       : m_displayOutput(DisplayOutput::Unknown),
@@ -117,6 +129,9 @@ class Calculation {
       "10000000000000000";
 
   void setHeights(KDCoordinate height, KDCoordinate expandedHeight);
+  const char* textAtIndex(int index) const;
+  const char* treeAtIndex(int index, TreeSize* size) const;
+  Poincare::Expression expressionAtIndex(int index) const;
 
   /* Buffers holding text expressions have to be longer than the text written
    * by user (of maximum length TextField::MaxBufferSize()) because when we
@@ -2,6 +2,7 @@
 
 #include <apps/shared/expression_display_permissions.h>
 #include <poincare/circuit_breaker_checkpoint.h>
+#include <poincare/exception_checkpoint.h>
 #include <poincare/rational.h>
 #include <poincare/store.h>
 #include <poincare/symbol.h>
@@ -220,6 +221,14 @@ ExpiringPointer<Calculation> CalculationStore::push(
     cursor = nextCursor;
   }
 
+  // Push the trees parsed from the texts
+  for (int i = 0; i < Calculation::k_numberOfExpressions; i++) {
+    cursor = pushTree(cursor, i);
+    if (cursor == k_pushError) {
+      return errorPushUndefined(heightComputer);
+    }
+  }
+
   /* All data has been appended, store the pointer to the end of the
    * calculation. */
   assert(cursor < pointerArea() - sizeof(Calculation *));
@@ -293,7 +302,19 @@ size_t CalculationStore::privateDeleteCalculationAtIndex(
 ExpiringPointer<Calculation> CalculationStore::errorPushUndefined(
     HeightComputer heightComputer) {
   assert(numberOfCalculations() == 0);
-  char *cursor = pushUndefined(m_buffer);
+  char *cursor = pushEmptyCalculation(m_buffer);
+  for (int i = 0;
+       cursor != k_pushError && i < Calculation::k_numberOfExpressions; i++) {
+    cursor = pushUndefined(cursor);
+  }
+  for (int i = 0;
+       cursor != k_pushError && i < Calculation::k_numberOfExpressions; i++) {
+    cursor = pushTree(cursor, i);
+  }
+  if (cursor == k_pushError) {
+    // Not even an undefined calculation fits, the store is left empty
+    return ExpiringPointer<Calculation>(nullptr);
+  }
   assert(m_buffer < cursor &&
          cursor <= m_buffer + m_bufferSize - sizeof(Calculation *));
   *(pointerArray() - 1) = cursor;
@@ -336,6 +357,45 @@ char *CalculationStore::pushSerializedExpression(
   assert(false);
 }
 
+char *CalculationStore::pushTree(char *location, int index) {
+  /* The calculation being pushed starts at the end of the previous ones, which
+   * move when the oldest calculations are deleted. */
+  const char *text =
+      reinterpret_cast<Calculation *>(endOfCalculations())->textAtIndex(index);
+  Expression e;
+  {
+    ExceptionCheckpoint ecp;
+    if (ExceptionRun(ecp)) {
+      e = Expression::Parse(text, nullptr);
+    }
+  }
+  /* Only keep the trees that fit with their text in the space of a serialized
+   * expression, so that k_minimalSize still bounds the size of a calculation.
+   * The texts of bigger trees are parsed instead. */
+  Calculation::TreeSize size = 0;
+  if (!e.isUninitialized() &&
+      strlen(text) + 1 + e.size() <= Constant::MaxSerializedExpressionSize) {
+    size = e.size();
+  }
+  while (spaceForNewCalculations(location) <
+         static_cast<int>(sizeof(Calculation::TreeSize) + size)) {
+    if (numberOfCalculations() == 0) {
+      if (size == 0) {
+        return k_pushError;
+      }
+      // The text will be parsed instead
+      size = 0;
+      continue;
+    }
+    location -= deleteOldestCalculation(location);
+  }
+  memcpy(location, &size, sizeof(Calculation::TreeSize));
+  if (size > 0) {
+    memcpy(location + sizeof(Calculation::TreeSize), e.addressInPool(), size);
+  }
+  return location + sizeof(Calculation::TreeSize) + size;
+}
+
 char *CalculationStore::pushUndefined(char *location) {
   return pushSerializedExpression(
       location, Undefined::Builder(),
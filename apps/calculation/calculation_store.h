@@ -99,6 +99,9 @@ class CalculationStore {
   char *pushEmptyCalculation(char *location);
   char *pushSerializedExpression(char *location, Poincare::Expression e,
                                  int numberOfSignificantDigits);
+  /* Push the tree parsed from the text of index index of the calculation being
+   * pushed, or an empty tree if it does not fit. */
+  char *pushTree(char *location, int index);
   char *pushUndefined(char *location);
 
   char *const m_buffer;
@@ -136,6 +136,42 @@ QUIZ_CASE(calculation_store) {
               static_cast<int>(store.bufferSize()));
 }
 
+void assert_expression_is_parsed_text(Expression e, const char *text) {
+  quiz_assert_print_if_failure(
+      e.isIdenticalTo(Expression::Parse(text, nullptr)), text);
+}
+
+QUIZ_CASE(calculation_store_trees) {
+  Shared::GlobalContext globalContext;
+  CalculationStore store(calculationBuffer, calculationBufferSize);
+  const char *inputs[] = {"1+3/4", "√(2)/2", "cos(π/4)", "123456780",
+                          "[[1,2][3,4]]", "3→a", "2_km", "ln(-1)"};
+  for (const char *input : inputs) {
+    store.push(input, &globalContext, dummyHeight);
+  }
+  Ion::Storage::FileSystem::sharedFileSystem->recordNamed("a.exp").destroy();
+  /* Expressions are copied from the trees stored with the calculations, and
+   * must be the same as the ones parsed from the texts. */
+  int n = sizeof(inputs) / sizeof(const char *);
+  quiz_assert(store.numberOfCalculations() == n);
+  for (int i = 0; i < n; i++) {
+    Shared::ExpiringPointer<::Calculation::Calculation> calculation =
+        store.calculationAtIndex(i);
+    assert_expression_is_parsed_text(calculation->input(),
+                                     calculation->inputText());
+    assert_expression_is_parsed_text(calculation->exactOutput(),
+                                     calculation->exactOutputText());
+    for (NumberOfSignificantDigits digits :
+         {NumberOfSignificantDigits::Maximal,
+          NumberOfSignificantDigits::UserDefined}) {
+      assert_expression_is_parsed_text(
+          calculation->approximateOutput(digits),
+          calculation->approximateOutputText(digits));
+    }
+  }
+  store.deleteAll();
+}
+
 void assertAnsIs(const char *input, const char *expectedAnsInputText,
                  Context *context, CalculationStore *store) {
   store->push(input, context, dummyHeight);
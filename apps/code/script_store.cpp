@@ -38,18 +38,18 @@ const char* ScriptStore::contentOfScript(const char* name, bool markAsFetched) {
 }
 
 void ScriptStore::clearVariableBoxFetchInformation() {
-  // TODO optimize fetches
-  const int scriptsCount = numberOfScripts();
-  for (int i = 0; i < scriptsCount; i++) {
-    scriptAtIndex(i).setFetchedForVariableBox(false);
+  for (Ion::Storage::Record record :
+       Ion::Storage::FileSystem::sharedFileSystem->recordsWithExtension(
+           k_scriptExtension)) {
+    Script(record).setFetchedForVariableBox(false);
   }
 }
 
 void ScriptStore::clearConsoleFetchInformation() {
-  // TODO optimize fetches
-  const int scriptsCount = numberOfScripts();
-  for (int i = 0; i < scriptsCount; i++) {
-    scriptAtIndex(i).setFetchedFromConsole(false);
+  for (Ion::Storage::Record record :
+       Ion::Storage::FileSystem::sharedFileSystem->recordsWithExtension(
+           k_scriptExtension)) {
+    Script(record).setFetchedFromConsole(false);
   }
 }
 
@@ -54,6 +54,9 @@ void GraphView::drawRecord(Ion::Storage::Record record, int index,
                            bool firstDrawnRecord) const {
   if (firstDrawnRecord) {
     m_areaIndex = 0;
+    /* Start the drawing before skipping undefined functions, so that caches
+     * used by the previous drawing can be evicted. */
+    functionStore()->startDrawing();
   }
 
   ExpiringPointer<ContinuousFunction> f =
@@ -81,7 +84,7 @@ void GraphView::drawRecord(Ion::Storage::Record record, int index,
     }
   }
 
-  ContinuousFunctionCache *cch = functionStore()->cacheAtIndex(index);
+  ContinuousFunctionCache *cch = functionStore()->cacheForRecord(record);
   float tmin = f->tMin();
   float tmax = f->tMax();
   Axis axis = f->isAlongY() ? Axis::Vertical : Axis::Horizontal;
@@ -246,6 +249,7 @@ void GraphView::drawCartesian(KDContext *ctx, KDRect rect,
                           tEnd, tStep, f->color(), true,
                           f->properties().plotIsDotted());
   firstCurve.setPrecisionOptions(true, evaluateXY<double>, discontinuity);
+  firstCurve.setAdaptiveSampling(true);
   firstCurve.setPatternOptions(pattern, patternStart, patternEnd, patternLower,
                                patternUpper, patternWithoutCurve, axis);
   firstCurve.draw(this, ctx, rect);
@@ -257,6 +261,7 @@ void GraphView::drawCartesian(KDContext *ctx, KDRect rect,
                              f->properties().plotIsDotted());
     secondCurve.setPrecisionOptions(true, evaluateXYSecondCurve<double>,
                                     discontinuity);
+    secondCurve.setAdaptiveSampling(true);
     secondCurve.setPatternOptions(pattern, patternStart, patternEnd,
                                   patternLower2, Curve2D(), patternWithoutCurve,
                                   axis);
@@ -45,7 +45,8 @@ void assert_cartesian_cache_stays_valid_while_panning(
     ContinuousFunction* function, Context* context,
     InteractiveCurveViewRange* range, CurveViewCursor* cursor,
     ContinuousFunctionStore* store, float step) {
-  ContinuousFunctionCache* cache = store->cacheAtIndex(0);
+  ContinuousFunctionCache* cache =
+      store->cacheForRecord(store->recordAtIndex(0));
   assert(cache);
 
   float tMin, tStep;
@@ -70,7 +71,8 @@ void assert_check_polar_cache_against_function(ContinuousFunction* function,
                                                Context* context,
                                                InteractiveCurveViewRange* range,
                                                ContinuousFunctionStore* store) {
-  ContinuousFunctionCache* cache = store->cacheAtIndex(0);
+  ContinuousFunctionCache* cache =
+      store->cacheForRecord(store->recordAtIndex(0));
   assert(cache);
 
   float tMin = range->xMin();
@@ -156,4 +158,103 @@ QUIZ_CASE(graph_caching) {
   Preferences::sharedPreferences->setAngleUnit(previousAngleUnit);
 }
 
+QUIZ_CASE(graph_caching_lru) {
+  GlobalContext globalContext;
+  ContinuousFunctionStore functionStore;
+  constexpr int numberOfCaches =
+      ContinuousFunctionCache::k_numberOfAvailableCaches;
+  constexpr int numberOfFunctions = numberOfCaches + 1;
+  for (int i = 0; i < numberOfFunctions; i++) {
+    addFunction("x", &functionStore, &globalContext);
+  }
+  Ion::Storage::Record records[numberOfFunctions];
+  for (int i = 0; i < numberOfFunctions; i++) {
+    records[i] = functionStore.recordAtIndex(i);
+  }
+
+  /* A drawing of all the functions keeps its caches for the first ones, each
+   * of them getting its own cache. */
+  ContinuousFunctionCache* caches[numberOfFunctions];
+  for (int drawing = 0; drawing < 2; drawing++) {
+    functionStore.startDrawing();
+    for (int i = 0; i < numberOfFunctions; i++) {
+      ContinuousFunctionCache* cache = functionStore.cacheForRecord(records[i]);
+      quiz_assert(drawing == 0 || cache == caches[i]);
+      caches[i] = cache;
+      ContinuousFunctionCache::PrepareForCaching(
+          functionStore.modelForRecord(records[i]).operator->(), cache, 0.f,
+          0.1f);
+    }
+  }
+  quiz_assert(caches[numberOfFunctions - 1] == nullptr);
+  for (int i = 0; i < numberOfCaches; i++) {
+    quiz_assert(caches[i] != nullptr);
+    for (int j = 0; j < i; j++) {
+      quiz_assert(caches[i] != caches[j]);
+    }
+  }
+
+  /* Drawing the last function alone takes the cache of the least recently
+   * drawn function, which is the second one. */
+  functionStore.startDrawing();
+  functionStore.cacheForRecord(records[0]);
+  for (int i = 2; i < numberOfCaches; i++) {
+    functionStore.cacheForRecord(records[i]);
+  }
+  ContinuousFunction* lastFunction =
+      functionStore.modelForRecord(records[numberOfFunctions - 1]).operator->();
+  functionStore.startDrawing();
+  ContinuousFunctionCache* lastCache =
+      functionStore.cacheForRecord(records[numberOfFunctions - 1]);
+  quiz_assert(lastCache == caches[1]);
+  ContinuousFunctionCache::PrepareForCaching(lastFunction, lastCache, 0.f,
+                                             0.1f);
+  quiz_assert(lastFunction->cache() == lastCache);
+
+  // The second function lost its cache and takes the one of another function
+  ContinuousFunction* secondFunction =
+      functionStore.modelForRecord(records[1]).operator->();
+  quiz_assert(secondFunction->cache() == nullptr);
+  ContinuousFunctionCache* secondCache =
+      functionStore.cacheForRecord(records[1]);
+  quiz_assert(secondCache != nullptr && secondCache != lastCache);
+
+  functionStore.removeAll();
+}
+
+QUIZ_CASE(graph_caching_lru_skipped_first_function) {
+  GlobalContext globalContext;
+  ContinuousFunctionStore functionStore;
+  constexpr int numberOfCaches =
+      ContinuousFunctionCache::k_numberOfAvailableCaches;
+  addFunction("undef", &functionStore, &globalContext);
+  for (int i = 0; i < numberOfCaches; i++) {
+    addFunction("x", &functionStore, &globalContext);
+  }
+
+  /* The undefined first function is not drawn and never asks for a cache.
+   * The drawn functions keep their caches from one drawing to the next. */
+  ContinuousFunctionCache* caches[numberOfCaches];
+  for (int drawing = 0; drawing < 3; drawing++) {
+    functionStore.startDrawing();
+    for (int i = 0; i < numberOfCaches; i++) {
+      ContinuousFunctionCache* cache =
+          functionStore.cacheForRecord(functionStore.recordAtIndex(i + 1));
+      quiz_assert(cache != nullptr);
+      quiz_assert(drawing == 0 || cache == caches[i]);
+      caches[i] = cache;
+    }
+  }
+
+  // Once redefined, the first function takes the least recently drawn cache
+  functionStore.startDrawing();
+  for (int i = 1; i < numberOfCaches; i++) {
+    functionStore.cacheForRecord(functionStore.recordAtIndex(i + 1));
+  }
+  quiz_assert(functionStore.cacheForRecord(functionStore.recordAtIndex(0)) ==
+              caches[0]);
+
+  functionStore.removeAll();
+}
+
 }  // namespace Graph
@@ -344,7 +344,7 @@ QUIZ_CASE(regression_power) {
   constexpr double y4[] = {10.0, 10.0, 10.0, 10.0, 10.0,
                            10.0, 10.0, 10.0, 10.0, 10.0};
   static_assert(std::size(x4) == std::size(y4), "Column sizes are different");
-  constexpr double coefficients4[] = {10.0, -2.75494376E-15};  // FIXME
+  constexpr double coefficients4[] = {10.0, 0.0};
   constexpr double r4 = 1.0;
   constexpr double r24 = 1.0;
   constexpr double sr4 = 0.0;
@@ -1,5 +1,6 @@
 #include "continuous_function_cache.h"
 
+#include <ion/counters.h>
 #include <limits.h>
 #include <omg/signaling_nan.h>
 
@@ -11,6 +12,9 @@ constexpr int ContinuousFunctionCache::k_sizeOfCache;
 constexpr float ContinuousFunctionCache::k_cacheHitTolerance;
 constexpr int ContinuousFunctionCache::k_numberOfAvailableCaches;
 
+static Ion::Counters::Counter s_cacheHits("function_cache_hits");
+static Ion::Counters::Counter s_cacheMisses("function_cache_misses");
+
 // public
 void ContinuousFunctionCache::PrepareForCaching(void *fun,
                                                 ContinuousFunctionCache *cache,
@@ -18,10 +22,9 @@ void ContinuousFunctionCache::PrepareForCaching(void *fun,
   ContinuousFunction *function = static_cast<ContinuousFunction *>(fun);
 
   if (!cache) {
-    /* ContinuousFunctionStore::cacheAtIndex has returned a nullptr : the index
-     * of the function we are trying to draw is greater than the number of
-     * available caches, so we just tell the function to not lookup any cache.
-     */
+    /* ContinuousFunctionStore::cacheForRecord has returned a nullptr: all the
+     * caches are used by other functions of the current drawing, so we just
+     * tell the function to not lookup any cache. */
     function->setCache(nullptr);
     return;
   }
@@ -45,7 +48,8 @@ void ContinuousFunctionCache::PrepareForCaching(void *fun,
     cache->clear();
     function->setCache(cache);
   } else if (tStep != 0.f && tStep != cache->step()) {
-    cache->clear();
+    // Zooming keeps the compiled program of the function
+    cache->invalidateValues();
   }
 
   if (function->properties().isCartesian() && tStep != 0) {
@@ -55,9 +59,9 @@ void ContinuousFunctionCache::PrepareForCaching(void *fun,
 }
 
 void ContinuousFunctionCache::clear() {
-  m_startOfCache = 0;
-  m_tStep = 0;
-  invalidateBetween(0, k_sizeOfCache);
+  m_program.clear();
+  m_programStatus = ProgramStatus::None;
+  invalidateValues();
 }
 
 Poincare::Coordinate2D<float> ContinuousFunctionCache::valueForParameter(
@@ -65,7 +69,8 @@ Poincare::Coordinate2D<float> ContinuousFunctionCache::valueForParameter(
     int curveIndex) {
   int resIndex = indexForParameter(function, t, curveIndex);
   if (resIndex < 0) {
-    return function->privateEvaluateXYAtParameter(t, context, curveIndex);
+    s_cacheMisses.add();
+    return evaluate(function, context, t, curveIndex);
   }
   return valuesAtIndex(function, context, t, resIndex, curveIndex);
 }
@@ -98,6 +103,12 @@ void ContinuousFunctionCache::ComputeNonCartesianSteps(float *tStep,
 }
 
 // private
+void ContinuousFunctionCache::invalidateValues() {
+  m_startOfCache = 0;
+  m_tStep = 0;
+  invalidateBetween(0, k_sizeOfCache);
+}
+
 void ContinuousFunctionCache::invalidateBetween(int iInf, int iSup) {
   for (int i = iInf; i < iSup; i++) {
     m_cache[i] = OMG::SignalingNan<float>();
@@ -140,16 +151,28 @@ Poincare::Coordinate2D<float> ContinuousFunctionCache::valuesAtIndex(
     int i, int curveIndex) {
   assert(curveIndex == 0);
   if (function->properties().isCartesian()) {
-    if (OMG::IsSignalingNan(m_cache[i])) {
-      m_cache[i] =
-          function->privateEvaluateXYAtParameter(t, context, curveIndex).y();
+    if (!OMG::IsSignalingNan(m_cache[i])) {
+      s_cacheHits.add();
+    } else {
+      s_cacheMisses.add();
+      if (m_programStatus == ProgramStatus::None) {
+        compileProgram(function, context);
+      }
+      if (m_programStatus == ProgramStatus::Compiled) {
+        fillCartesianCache(function);
+      } else {
+        m_cache[i] = evaluate(function, context, t, curveIndex).y();
+      }
     }
     return Poincare::Coordinate2D<float>(t, m_cache[i]);
   }
-  if (OMG::IsSignalingNan(m_cache[2 * i]) ||
-      OMG::IsSignalingNan(m_cache[2 * i + 1])) {
+  if (!OMG::IsSignalingNan(m_cache[2 * i]) &&
+      !OMG::IsSignalingNan(m_cache[2 * i + 1])) {
+    s_cacheHits.add();
+  } else {
+    s_cacheMisses.add();
     Poincare::Coordinate2D<float> res =
-        function->privateEvaluateXYAtParameter(t, context, curveIndex);
+        evaluate(function, context, t, curveIndex);
     m_cache[2 * i] = res.x();
     m_cache[2 * i + 1] = res.y();
   }
@@ -166,7 +189,7 @@ void ContinuousFunctionCache::pan(ContinuousFunction *function, float newTMin) {
   m_tMin = newTMin;
   // Conversion from int to float changes INT_MAX from 2147483647 to 2147483648
   if (std::fabs(dT) >= static_cast<float>(INT_MAX)) {
-    clear();
+    invalidateValues();
     return;
   }
   /* TODO : Instead of invalidating the entire cache when
@@ -177,7 +200,7 @@ void ContinuousFunctionCache::pan(ContinuousFunction *function, float newTMin) {
   int dI = std::round(dT);
   if (dI >= k_sizeOfCache || dI <= -k_sizeOfCache ||
       std::fabs(dT - dI) > k_cacheHitTolerance) {
-    clear();
+    invalidateValues();
     return;
   }
 
@@ -203,4 +226,68 @@ void ContinuousFunctionCache::pan(ContinuousFunction *function, float newTMin) {
   }
 }
 
+Poincare::Coordinate2D<float> ContinuousFunctionCache::evaluate(
+    const ContinuousFunction *function, Poincare::Context *context, float t,
+    int curveIndex) {
+  if (m_programStatus == ProgramStatus::None) {
+    compileProgram(function, context);
+  }
+  if (m_programStatus == ProgramStatus::Uncompilable || curveIndex != 0) {
+    return function->privateEvaluateXYAtParameter(t, context, curveIndex);
+  }
+  // Same domain as ContinuousFunction::templatedApproximateAtParameter
+  if (t < function->tMin() || t > function->tMax()) {
+    return Poincare::Coordinate2D<float>(t, NAN);
+  }
+  return Poincare::Coordinate2D<float>(t, m_program.evaluate(t));
+}
+
+void ContinuousFunctionCache::fillCartesianCache(
+    const ContinuousFunction *function) {
+  assert(m_programStatus == ProgramStatus::Compiled);
+  constexpr int k_batchSize =
+      Poincare::ApproximationProgram<float>::k_batchSize;
+  float t[k_batchSize];
+  float y[k_batchSize];
+  int indexes[k_batchSize];
+  int n = 0;
+  float tMin = function->tMin();
+  float tMax = function->tMax();
+  for (int j = 0; j < k_sizeOfCache; j++) {
+    int i = (j + m_startOfCache) % k_sizeOfCache;
+    if (OMG::IsSignalingNan(m_cache[i])) {
+      float tj = m_tMin + j * m_tStep;
+      if (tj < tMin || tj > tMax) {
+        m_cache[i] = NAN;
+      } else {
+        t[n] = tj;
+        indexes[n++] = i;
+      }
+    }
+    if (n == k_batchSize || (n > 0 && j == k_sizeOfCache - 1)) {
+      m_program.evaluate(t, y, n);
+      for (int k = 0; k < n; k++) {
+        m_cache[indexes[k]] = y[k];
+      }
+      n = 0;
+    }
+  }
+}
+
+void ContinuousFunctionCache::compileProgram(
+    const ContinuousFunction *function, Poincare::Context *context) {
+  m_programStatus = ProgramStatus::Uncompilable;
+  if (!function->properties().isCartesian() || function->isAlongY() ||
+      function->numberOfSubCurves() != 1) {
+    return;
+  }
+  Poincare::Preferences::AngleUnit angleUnit =
+      Poincare::Preferences::sharedPreferences->angleUnit();
+  if (m_program.compile(function->expressionApproximated(context),
+                        ContinuousFunction::k_unknownName, context,
+                        function->complexFormat(context), angleUnit)) {
+    m_programStatus = ProgramStatus::Compiled;
+  }
+}
+
 }  // namespace Shared
@@ -3,16 +3,24 @@
 
 #include <float.h>
 #include <ion/display.h>
+#include <poincare/approximation_program.h>
 #include <poincare/context.h>
 #include <poincare/coordinate_2D.h>
 
+/* Number of functions whose values are cached at once. Each cache takes about
+ * 2kB of RAM. */
+#ifndef SHARED_NUMBER_OF_FUNCTION_CACHES
+#define SHARED_NUMBER_OF_FUNCTION_CACHES 4
+#endif
+
 namespace Shared {
 
 class ContinuousFunction;
 
 class ContinuousFunctionCache {
  public:
-  constexpr static int k_numberOfAvailableCaches = 2;
+  constexpr static int k_numberOfAvailableCaches =
+      SHARED_NUMBER_OF_FUNCTION_CACHES;
 
   static void PrepareForCaching(void* fun, ContinuousFunctionCache* cache,
                                 float tMin, float tStep);
@@ -50,10 +58,15 @@ class ContinuousFunctionCache {
    * which would lead to no curve at all. With 80.0938275501223, the
    * problematic functions are the functions whose period is proportioned to
    * 80.0938275501223 which are hopefully rare enough.
-   * TODO: The drawCurve algorithm should use the derivative function to know
-   * how fast the function moves... */
+   * Cartesian curves are drawn with adaptive sampling, which lengthens the
+   * step where the curve is flat (see CurveDrawing::setAdaptiveSampling). */
   constexpr static float k_graphStepDenominator = 80.0938275501223f;
 
+  enum class ProgramStatus : uint8_t { None, Compiled, Uncompilable };
+
+  /* Invalidates the values but keeps the program, which only depends on the
+   * function. */
+  void invalidateValues();
   void invalidateBetween(int iInf, int iSup);
   void setRange(float tMin, float tStep);
   int indexForParameter(const ContinuousFunction* function, float t,
@@ -62,6 +75,16 @@ class ContinuousFunctionCache {
       const ContinuousFunction* function, Poincare::Context* context, float t,
       int i, int curveIndex);
   void pan(ContinuousFunction* function, float newTMin);
+  /* Evaluates the function with m_program if it can be compiled, and falls
+   * back on the function's expression otherwise. */
+  Poincare::Coordinate2D<float> evaluate(const ContinuousFunction* function,
+                                         Poincare::Context* context, float t,
+                                         int curveIndex);
+  void compileProgram(const ContinuousFunction* function,
+                      Poincare::Context* context);
+  /* Evaluates m_program at once on all the invalid indexes of the cache of a
+   * cartesian function. */
+  void fillCartesianCache(const ContinuousFunction* function);
 
   float m_tMin, m_tStep;
   float m_cache[k_sizeOfCache];
@@ -69,6 +92,10 @@ class ContinuousFunctionCache {
    * with cartesian functions. When dealing with parametric or polar functions,
    * m_startOfCache should be zero.*/
   int m_startOfCache;
+  /* The program of cartesian functions, compiled the first time the function
+   * is evaluated after a clear. */
+  Poincare::ApproximationProgram<float> m_program;
+  ProgramStatus m_programStatus;
 };
 
 }  // namespace Shared
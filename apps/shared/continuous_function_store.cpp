@@ -1,9 +1,12 @@
 #include "continuous_function_store.h"
 
 #include <ion.h>
+#include <ion/counters.h>
 
 namespace Shared {
 
+static Ion::Counters::Counter s_cacheEvictions("function_cache_evictions");
+
 bool ContinuousFunctionStore::displaysNonCartesianFunctions(
     int* nbActiveFunctions) const {
   int nActive = numberOfActiveFunctions();
@@ -45,6 +48,41 @@ Ion::Storage::Record::ErrorStatus ContinuousFunctionStore::addEmptyModel() {
   return error;
 }
 
+ContinuousFunctionCache* ContinuousFunctionStore::cacheForRecord(
+    Ion::Storage::Record record) const {
+  constexpr int k_numberOfCaches =
+      ContinuousFunctionCache::k_numberOfAvailableCaches;
+  int index = 0;
+  for (int i = 0; i < k_numberOfCaches; i++) {
+    if (m_cacheRecords[i] == record) {
+      m_cacheLastDrawings[i] = m_drawingIndex;
+      return m_functionCaches + i;
+    }
+    if (m_cacheLastDrawings[i] < m_cacheLastDrawings[index]) {
+      index = i;
+    }
+  }
+  /* Caches used by the current drawing are not evicted: drawing more
+   * functions than there are caches would otherwise evict each cache right
+   * before it is needed. */
+  if (!m_cacheRecords[index].isNull() &&
+      m_cacheLastDrawings[index] == m_drawingIndex) {
+    return nullptr;
+  }
+  s_cacheEvictions.add();
+  ContinuousFunctionCache* cache = m_functionCaches + index;
+  m_cacheRecords[index] = record;
+  m_cacheLastDrawings[index] = m_drawingIndex;
+  /* Functions still pointing to the evicted cache would read the values of
+   * its new function. PrepareForCaching clears it for the new one. */
+  for (int i = 0; i < k_maxNumberOfMemoizedModels; i++) {
+    if (m_functions[i].cache() == cache) {
+      m_functions[i].setCache(nullptr);
+    }
+  }
+  return cache;
+}
+
 ExpressionModelHandle* ContinuousFunctionStore::setMemoizedModelAtIndex(
     int cacheIndex, Ion::Storage::Record record) const {
   assert(cacheIndex >= 0 && cacheIndex < maxNumberOfMemoizedModels());
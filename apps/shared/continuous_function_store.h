@@ -21,7 +21,11 @@ class ContinuousFunctionStore : public FunctionStore {
            static_cast<ContinuousFunction *>(model)->canDisplayDerivative();
   }
 
-  ContinuousFunctionStore() : FunctionStore() {}
+  ContinuousFunctionStore() : FunctionStore(), m_drawingIndex(0) {
+    for (uint32_t &lastDrawing : m_cacheLastDrawings) {
+      lastDrawing = 0;
+    }
+  }
   int numberOfActiveFunctionsInTable() const {
     return numberOfModelsSatisfyingTest(&IsFunctionActiveInTable, nullptr);
   }
@@ -60,11 +64,13 @@ class ContinuousFunctionStore : public FunctionStore {
   KDColor colorForRecord(Ion::Storage::Record record) const override {
     return modelForRecord(record)->color();
   }
-  ContinuousFunctionCache *cacheAtIndex(int i) const {
-    return (i < ContinuousFunctionCache::k_numberOfAvailableCaches)
-               ? m_functionCaches + i
-               : nullptr;
-  }
+  // Must be called once at the beginning of each drawing of the functions
+  void startDrawing() const { m_drawingIndex++; }
+  /* Returns the cache of the function of record. When no cache is attributed
+   * to it, the one least recently used by a drawing is taken from its
+   * function, or nullptr is returned if all of them are used by the current
+   * drawing. */
+  ContinuousFunctionCache *cacheForRecord(Ion::Storage::Record record) const;
   Ion::Storage::Record::ErrorStatus addEmptyModel() override;
   int maxNumberOfModels() const override { return k_maxNumberOfModels; }
 
@@ -111,6 +117,12 @@ class ContinuousFunctionStore : public FunctionStore {
   mutable ContinuousFunction m_functions[k_maxNumberOfMemoizedModels];
   mutable ContinuousFunctionCache
       m_functionCaches[ContinuousFunctionCache::k_numberOfAvailableCaches];
+  // Owner and index of the last drawing using each cache
+  mutable Ion::Storage::Record
+      m_cacheRecords[ContinuousFunctionCache::k_numberOfAvailableCaches];
+  mutable uint32_t
+      m_cacheLastDrawings[ContinuousFunctionCache::k_numberOfAvailableCaches];
+  mutable uint32_t m_drawingIndex;
 };
 
 }  // namespace Shared
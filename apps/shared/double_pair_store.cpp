@@ -281,30 +281,6 @@ int DoublePairStore::activeSeriesIndexFromSeriesIndex(
   return activeSeriesCount;
 }
 
-static void swapRows(int a, int b, void *ctx, int numberOfElements) {
-  // Swap X and Y values
-  void **pack = reinterpret_cast<void **>(ctx);
-  DoublePairStore *store = reinterpret_cast<DoublePairStore *>(pack[0]);
-  int *series = reinterpret_cast<int *>(pack[1]);
-  double dataAx = store->get(*series, 0, a);
-  double dataAy = store->get(*series, 1, a);
-  store->set(store->get(*series, 0, b), *series, 0, a, true);
-  store->set(store->get(*series, 1, b), *series, 1, a, true);
-  store->set(dataAx, *series, 0, b, true);
-  store->set(dataAy, *series, 1, b, true);
-};
-
-static bool compare(int a, int b, void *ctx, int numberOfElements) {
-  void **pack = reinterpret_cast<void **>(ctx);
-  const DoublePairStore *store =
-      reinterpret_cast<const DoublePairStore *>(pack[0]);
-  int *series = reinterpret_cast<int *>(pack[1]);
-  int *column = reinterpret_cast<int *>(pack[2]);
-  double dataA = store->get(*series, *column, a);
-  double dataB = store->get(*series, *column, b);
-  return dataA >= dataB || std::isnan(dataA);
-};
-
 double DoublePairStore::CalculationOptions::transformValue(double value,
                                                            int i) const {
   value *= oppositeOfValue(i) ? -1.0 : 1.0;
@@ -313,10 +289,36 @@ double DoublePairStore::CalculationOptions::transformValue(double value,
 
 void DoublePairStore::sortColumn(int series, int column, bool delayUpdate) {
   assert(column == 0 || column == 1);
-
-  void *context[] = {const_cast<DoublePairStore *>(this), &series, &column};
-  Poincare::Helpers::Sort(swapRows, compare, context,
-                          numberOfPairsOfSeries(series));
+  int numberOfPairs = numberOfPairsOfSeries(series);
+  if (numberOfPairs == 0) {
+    return;
+  }
+  /* Sort an index rather than the rows: the index sort is stable, so that
+   * pairs with the same value keep their order. */
+  uint8_t sortedIndex[k_maxNumberOfPairs];
+  for (int i = 0; i < numberOfPairs; i++) {
+    sortedIndex[i] = i;
+  }
+  sortIndexByColumn(sortedIndex, series, column, 0, numberOfPairs);
+  // Move the rows along the cycles of the permutation
+  for (int i = 0; i < numberOfPairs; i++) {
+    if (sortedIndex[i] == i) {
+      continue;
+    }
+    double x = get(series, 0, i);
+    double y = get(series, 1, i);
+    int j = i;
+    while (sortedIndex[j] != i) {
+      int next = sortedIndex[j];
+      set(get(series, 0, next), series, 0, j, true);
+      set(get(series, 1, next), series, 1, j, true);
+      sortedIndex[j] = j;
+      j = next;
+    }
+    set(x, series, 0, j, true);
+    set(y, series, 1, j, true);
+    sortedIndex[j] = j;
+  }
   updateSeries(series, delayUpdate);
 }
 
@@ -341,8 +343,16 @@ void DoublePairStore::sortIndexByColumn(uint8_t *sortedIndex, int series,
         uint8_t *sortedIndex = reinterpret_cast<uint8_t *>(pack[1]);
         int series = *reinterpret_cast<int *>(pack[2]);
         int column = *reinterpret_cast<int *>(pack[3]);
-        return store->get(series, column, sortedIndex[i]) >=
-               store->get(series, column, sortedIndex[j]);
+        double dataI = store->get(series, column, sortedIndex[i]);
+        double dataJ = store->get(series, column, sortedIndex[j]);
+        // NaN values go last and equal values are ordered by index
+        bool equal = std::isnan(dataI) || std::isnan(dataJ)
+                         ? std::isnan(dataI) == std::isnan(dataJ)
+                         : dataI == dataJ;
+        if (equal) {
+          return sortedIndex[i] > sortedIndex[j];
+        }
+        return std::isnan(dataI) || dataI > dataJ;
       },
       pack, endIndex - startIndex);
 }
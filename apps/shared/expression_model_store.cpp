@@ -50,13 +50,12 @@ void ExpressionModelStore::tidyDownstreamPoolFrom(
 int ExpressionModelStore::numberOfModelsSatisfyingTest(ModelTest test,
                                                        void* context) const {
   int count = 0;
-  int index = 0;
-  Ion::Storage::Record record = recordAtIndex(0);
-  while (!record.isNull()) {
+  for (Ion::Storage::Record record :
+       Ion::Storage::FileSystem::sharedFileSystem->recordsWithExtension(
+           modelExtension())) {
     if (test(privateModelForRecord(record), context)) {
       count++;
     }
-    record = recordAtIndex(++index);
   }
   return count;
 }
@@ -65,23 +64,21 @@ Ion::Storage::Record ExpressionModelStore::recordSatisfyingTestAtIndex(
     int i, ModelTest test, void* context) const {
   assert(i >= 0);
   int count = 0;
-  int index = 0;
-  Ion::Storage::Record record = recordAtIndex(0);
-  while (!record.isNull()) {
+  for (Ion::Storage::Record record :
+       Ion::Storage::FileSystem::sharedFileSystem->recordsWithExtension(
+           modelExtension())) {
     if (test(privateModelForRecord(record), context)) {
       if (i == count) {
-        break;
+        return record;
       }
       count++;
     }
-    record = recordAtIndex(++index);
   }
-  /* Returned record is null if i >= numberOfModelsSatisfyingTest.
-   * We'd like to assert that i < numberOfModelsStatisfyingTest at the
-   * beginning of this function but the method numberOfModelsStatisfyingTest
-   * is not const. */
-  assert(!record.isNull());
-  return record;
+  /* Reached if i >= numberOfModelsSatisfyingTest. We'd like to assert that
+   * i < numberOfModelsStatisfyingTest at the beginning of this function but
+   * the method numberOfModelsStatisfyingTest is not const. */
+  assert(false);
+  return Ion::Storage::Record();
 }
 
 void ExpressionModelStore::resetMemoizedModelsExceptRecord(
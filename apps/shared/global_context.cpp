@@ -2,6 +2,7 @@
 
 #include <apps/apps_container.h>
 #include <assert.h>
+#include <ion/counters.h>
 #include <poincare/function.h>
 #include <poincare/rational.h>
 #include <poincare/serialization_helper.h>
@@ -24,6 +25,9 @@ constexpr const char *GlobalContext::k_extensions[];
 OMG::GlobalBox<SequenceStore> GlobalContext::sequenceStore;
 OMG::GlobalBox<ContinuousFunctionStore> GlobalContext::continuousFunctionStore;
 
+static Ion::Counters::Counter s_memoizedSymbolHits("memoized_symbol_hits");
+static Ion::Counters::Counter s_memoizedSymbolMisses("memoized_symbol_misses");
+
 void GlobalContext::storageDidChangeForRecord(Ion::Storage::Record record) {
   m_sequenceContext.resetCache();
   GlobalContext::sequenceStore->storageDidChangeForRecord(record);
@@ -94,11 +98,27 @@ Context::SymbolAbstractType GlobalContext::expressionTypeForIdentifier(
 const Expression GlobalContext::protectedExpressionForSymbolAbstract(
     const Poincare::SymbolAbstract &symbol, bool clone,
     Poincare::ContextWithParent *lastDescendantContext) {
-  Ion::Storage::Record r = SymbolAbstractRecordWithBaseName(symbol.name());
-  return expressionForSymbolAndRecord(
-      symbol, r,
-      lastDescendantContext ? static_cast<Context *>(lastDescendantContext)
-                            : static_cast<Context *>(this));
+  const MemoizedSymbol *memo = memoizedSymbol(symbol);
+  if (!memo) {
+    Ion::Storage::Record r = SymbolAbstractRecordWithBaseName(symbol.name());
+    return expressionForSymbolAndRecord(
+        symbol, r,
+        lastDescendantContext ? static_cast<Context *>(lastDescendantContext)
+                              : static_cast<Context *>(this));
+  }
+  if (memo->expressionSize == 0) {
+    return Expression();
+  }
+  Ion::Storage::Record::Data d = memo->record.value();
+  assert(d.size >= memo->expressionSize);
+  Expression e = Expression::ExpressionFromAddress(
+      static_cast<const char *>(d.buffer) + d.size - memo->expressionSize,
+      memo->expressionSize);
+  if (symbol.type() == ExpressionNode::Type::Function) {
+    e = e.replaceSymbolWithExpression(Symbol::SystemSymbol(),
+                                      symbol.childAtIndex(0));
+  }
+  return e;
 }
 
 bool GlobalContext::setExpressionForSymbolAbstract(
@@ -283,6 +303,60 @@ Ion::Storage::Record GlobalContext::SymbolAbstractRecordWithBaseName(
       ->recordBaseNamedWithExtensions(name, k_extensions, k_numberOfExtensions);
 }
 
+const GlobalContext::MemoizedSymbol *GlobalContext::memoizedSymbol(
+    const SymbolAbstract &symbol) {
+  const char *name = symbol.name();
+  if ((symbol.type() != ExpressionNode::Type::Symbol &&
+       symbol.type() != ExpressionNode::Type::Function) ||
+      name[0] == 0 || strlen(name) >= SymbolAbstractNode::k_maxNameSize) {
+    return nullptr;
+  }
+  uint32_t storageVersion =
+      Ion::Storage::FileSystem::sharedFileSystem->version();
+  if (storageVersion != m_memoizedStorageVersion) {
+    for (MemoizedSymbol &memo : m_memoizedSymbols) {
+      memo.name[0] = 0;
+    }
+    m_memoizedStorageVersion = storageVersion;
+  }
+  for (const MemoizedSymbol &memo : m_memoizedSymbols) {
+    if (memo.type == symbol.type() && strcmp(memo.name, name) == 0) {
+      s_memoizedSymbolHits.add();
+      return &memo;
+    }
+  }
+  s_memoizedSymbolMisses.add();
+  MemoizedSymbol *memo = m_memoizedSymbols + m_nextMemoizedSymbol;
+  m_nextMemoizedSymbol =
+      (m_nextMemoizedSymbol + 1) % k_numberOfMemoizedSymbols;
+  strlcpy(memo->name, name, SymbolAbstractNode::k_maxNameSize);
+  memo->type = symbol.type();
+  memo->record = SymbolAbstractRecordWithBaseName(name);
+  memo->expressionSize =
+      ExpressionSizeForSymbolAndRecord(symbol, memo->record);
+  return memo;
+}
+
+size_t GlobalContext::ExpressionSizeForSymbolAndRecord(
+    const SymbolAbstract &symbol, Ion::Storage::Record r) {
+  // These record values are the expression itself
+  if (symbol.type() == ExpressionNode::Type::Symbol
+          ? r.hasExtension(Ion::Storage::expExtension) ||
+                r.hasExtension(Ion::Storage::lisExtension) ||
+                r.hasExtension(Ion::Storage::matExtension)
+          : r.hasExtension(Ion::Storage::regExtension)) {
+    return r.value().size;
+  }
+  if (symbol.type() == ExpressionNode::Type::Function &&
+      r.hasExtension(Ion::Storage::funcExtension)) {
+    /* The expression of a function is the second child of the equation which
+     * ends the record value, so it is stored last. */
+    Expression e = ContinuousFunction(r).expressionClone();
+    return e.isUninitialized() ? 0 : e.size();
+  }
+  return 0;
+}
+
 void GlobalContext::tidyDownstreamPoolFrom(TreeNode *treePoolCursor) {
   sequenceStore->tidyDownstreamPoolFrom(treePoolCursor);
   continuousFunctionStore->tidyDownstreamPoolFrom(treePoolCursor);
@@ -35,7 +35,11 @@ class GlobalContext final : public Poincare::Context {
   static void DestroyRecordsBaseNamedWithoutExtension(const char *baseName,
                                                       const char *extension);
 
-  GlobalContext() : m_sequenceContext(this, sequenceStore){};
+  GlobalContext()
+      : m_sequenceContext(this, sequenceStore),
+        m_memoizedSymbols(),
+        m_nextMemoizedSymbol(0),
+        m_memoizedStorageVersion(0){};
   /* Expression for symbol
    * The expression recorded in global context is already an expression.
    * Otherwise, we would need the context and the angle unit to evaluate it */
@@ -80,7 +84,27 @@ class GlobalContext final : public Poincare::Context {
   // Record getter
   static Ion::Storage::Record SymbolAbstractRecordWithBaseName(
       const char *name);
+  // Memoization of symbols and functions definitions
+  struct MemoizedSymbol {
+    // An empty name marks a free slot
+    char name[Poincare::SymbolAbstractNode::k_maxNameSize];
+    Poincare::ExpressionNode::Type type;
+    Ion::Storage::Record record;
+    /* The expression is stored at the end of the record value. A null size
+     * means that the record does not define the symbol. */
+    size_t expressionSize;
+  };
+  constexpr static int k_numberOfMemoizedSymbols = 8;
+  const MemoizedSymbol *memoizedSymbol(const Poincare::SymbolAbstract &symbol);
+  static size_t ExpressionSizeForSymbolAndRecord(
+      const Poincare::SymbolAbstract &symbol, Ion::Storage::Record r);
   SequenceContext m_sequenceContext;
+  /* Definitions are memoized as record and size of the expression rather than
+   * as pool handles, that checkpoints could free. They are dropped when the
+   * storage version changes. */
+  MemoizedSymbol m_memoizedSymbols[k_numberOfMemoizedSymbols];
+  int m_nextMemoizedSymbol;
+  uint32_t m_memoizedStorageVersion;
 };
 
 }  // namespace Shared
@@ -1,5 +1,7 @@
 #include "plot_view_plots.h"
 
+#include <ion/counters.h>
+
 #include <algorithm>
 
 #include "float.h"
@@ -99,6 +101,11 @@ void WithCurves::Pattern::drawInLine(const AbstractPlotView *plotView,
 
 // WithCurves::CurveDrawing
 
+static Ion::Counters::Counter s_curveDrawings("curve_drawings");
+static Ion::Counters::Counter s_curveEvaluations("curve_evaluations");
+static Ion::Counters::Counter s_curveDoubleEvaluations(
+    "curve_double_evaluations");
+
 WithCurves::CurveDrawing::CurveDrawing(Curve2D curve, void *context,
                                        float tStart, float tEnd, float tStep,
                                        KDColor color, bool thick, bool dashed)
@@ -117,7 +124,8 @@ WithCurves::CurveDrawing::CurveDrawing(Curve2D curve, void *context,
       m_thick(thick),
       m_dashed(dashed),
       m_patternWithoutCurve(false),
-      m_drawStraightLinesEarly(true) {
+      m_drawStraightLinesEarly(true),
+      m_adaptiveSampling(false) {
   assert(std::isfinite(m_tEnd) && std::isfinite(m_tStart));
   // Assert that the chosen step is not too small (ad-hoc value)
   assert((m_tEnd - m_tStart) / m_tStep < 10e5);
@@ -152,6 +160,7 @@ void WithCurves::CurveDrawing::draw(const AbstractPlotView *plotView,
   }
 
   plotView->setDashed(m_dashed);
+  s_curveDrawings.add();
 
   float previousT = NAN, t = NAN;
   Coordinate2D<float> previousXY, xy;
@@ -161,12 +170,19 @@ void WithCurves::CurveDrawing::draw(const AbstractPlotView *plotView,
   float (Coordinate2D<float>::*ordinate)() const =
       m_axis == AbstractPlotView::Axis::Horizontal ? &Coordinate2D<float>::y
                                                    : &Coordinate2D<float>::x;
+  /* Dots are computed every 2^stepExponent steps. The last three dots are
+   * kept to estimate how much the curve bends. */
+  bool adaptive =
+      m_adaptiveSampling && !m_patternLowerBound && !m_patternUpperBound;
+  int stepExponent = 0;
+  float lastT[3] = {NAN, NAN, NAN};
+  Coordinate2D<float> lastXY[3];
   int i = 0;
   bool isLastSegment = false;
 
   do {
     previousT = t;
-    t = m_tStart + (i++) * m_tStep;
+    t = m_tStart + i * m_tStep;
     if (t <= m_tStart) {
       t = m_tStart + FLT_EPSILON;
     }
@@ -176,10 +192,11 @@ void WithCurves::CurveDrawing::draw(const AbstractPlotView *plotView,
     }
     if (previousT == t) {
       // No need to draw segment. Happens when tStep << tStart .
+      i++;
       continue;
     }
     previousXY = xy;
-    xy = m_curve.evaluate(t, m_context);
+    xy = evaluate(t);
 
     // Draw a line with the pattern
     float patternMin =
@@ -205,13 +222,78 @@ void WithCurves::CurveDrawing::draw(const AbstractPlotView *plotView,
                            (xy.*abscissa)(), patternMin, patternMax);
     }
 
+    /* A longer segment needs more iterations to reach the same precision as
+     * the one of a single step. */
     joinDots(plotView, ctx, rect, previousT, previousXY, t, xy,
-             k_maxNumberOfIterations, m_discontinuity);
+             k_maxNumberOfIterations + stepExponent, m_discontinuity);
+
+    if (adaptive) {
+      lastT[0] = lastT[1];
+      lastT[1] = lastT[2];
+      lastT[2] = t;
+      lastXY[0] = lastXY[1];
+      lastXY[1] = lastXY[2];
+      lastXY[2] = xy;
+      stepExponent = nextStepExponent(plotView, stepExponent, lastT, lastXY);
+    }
+    i += 1 << stepExponent;
   } while (!isLastSegment);
 
   plotView->setDashed(false);
 }
 
+Coordinate2D<float> WithCurves::CurveDrawing::evaluate(float t) const {
+  s_curveEvaluations.add();
+  return m_curve.evaluate(t, m_context);
+}
+
+Coordinate2D<double> WithCurves::CurveDrawing::evaluateDouble(double t) const {
+  assert(m_curveDouble);
+  s_curveDoubleEvaluations.add();
+  return m_curveDouble(t, m_curve.model(), m_context);
+}
+
+int WithCurves::CurveDrawing::nextStepExponent(
+    const AbstractPlotView *plotView, int stepExponent, const float t[3],
+    const Coordinate2D<float> xy[3]) const {
+  /* The distance between a curve and its chord over a step h is about
+   * |p''|*h^2/8, where p is the curve in pixels. Its second derivative p'' is
+   * estimated with the divided differences of the last three dots. Steps are
+   * only doubled one at a time, and go back to tStep as soon as a dot is
+   * undefined. */
+  Coordinate2D<float> p[3];
+  for (int k = 0; k < 3; k++) {
+    if (std::isnan(t[k]) || !std::isfinite(xy[k].x()) ||
+        !std::isfinite(xy[k].y())) {
+      return 0;
+    }
+    p[k] = plotView->floatToPixel2D(xy[k]);
+  }
+  float dt01 = t[1] - t[0];
+  float dt12 = t[2] - t[1];
+  float secondDerivativeX = 2.f *
+                            ((p[2].x() - p[1].x()) / dt12 -
+                             (p[1].x() - p[0].x()) / dt01) /
+                            (dt01 + dt12);
+  float secondDerivativeY = 2.f *
+                            ((p[2].y() - p[1].y()) / dt12 -
+                             (p[1].y() - p[0].y()) / dt01) /
+                            (dt01 + dt12);
+  float secondDerivative =
+      std::sqrt(secondDerivativeX * secondDerivativeX +
+                secondDerivativeY * secondDerivativeY);
+  int maxExponent = std::min(stepExponent + 1, k_maxStepExponent);
+  int exponent = 0;
+  while (exponent < maxExponent) {
+    float h = m_tStep * (1 << (exponent + 1));
+    if (!(secondDerivative * h * h / 8.f <= k_adaptiveSamplingTolerance)) {
+      break;
+    }
+    exponent++;
+  }
+  return exponent;
+}
+
 static bool pointInBoundingBox(float x1, float y1, float x2, float y2, float xC,
                                float yC) {
   return ((x1 < xC && xC < x2) || (x2 < xC && xC < x1) ||
@@ -247,8 +329,7 @@ void WithCurves::CurveDrawing::joinDots(const AbstractPlotView *plotView,
      * as wrong points will be off by a large margin. */
     constexpr float pixelTolerance = 1.f;
     if (!m_curveDouble ||
-        (std::fabs(p2.y() - (plotView->floatToPixel2D(
-                                 m_curveDouble(t2, m_curve.model(), m_context)))
+        (std::fabs(p2.y() - (plotView->floatToPixel2D(evaluateDouble(t2)))
                                 .y()) < pixelTolerance)) {
       plotView->stamp(ctx, rect, p2, m_color, m_thick);
     }
@@ -256,7 +337,7 @@ void WithCurves::CurveDrawing::joinDots(const AbstractPlotView *plotView,
   }
 
   float t12 = 0.5f * (t1 + t2);
-  Coordinate2D<float> xy12 = m_curve.evaluate(t12, m_context);
+  Coordinate2D<float> xy12 = evaluate(t12);
 
   bool discontinuous = discontinuity(t1, t2, m_curve.model(), m_context);
   if (discontinuous) {
@@ -283,12 +364,9 @@ void WithCurves::CurveDrawing::joinDots(const AbstractPlotView *plotView,
         std::fabs((p2.y() - p1.y()) / (p2.x() - p1.x())) > dangerousSlope) {
       /* We need to make sure we're not drawing a vertical asymptote because of
        * rounding errors. */
-      Coordinate2D<double> xy1Double =
-          m_curveDouble(t1, m_curve.model(), m_context);
-      Coordinate2D<double> xy2Double =
-          m_curveDouble(t2, m_curve.model(), m_context);
-      Coordinate2D<double> xy12Double =
-          m_curveDouble(t12, m_curve.model(), m_context);
+      Coordinate2D<double> xy1Double = evaluateDouble(t1);
+      Coordinate2D<double> xy2Double = evaluateDouble(t2);
+      Coordinate2D<double> xy12Double = evaluateDouble(t12);
       if (pointInBoundingBox(xy1Double.x(), xy1Double.y(), xy2Double.x(),
                              xy2Double.y(), xy12Double.x(), xy12Double.y())) {
         plotView->straightJoinDots(
@@ -92,6 +92,12 @@ class WithCurves {
     void setPrecisionOptions(bool drawStraightLinesEarly,
                              Curve2DEvaluation<double> curveDouble,
                              DiscontinuityTest discontinuity);
+    /* In adaptive sampling mode, the step between two dots grows up to
+     * 2^k_maxStepExponent times tStep where the curve is flat enough. Curves
+     * with a pattern are always sampled at each step. */
+    void setAdaptiveSampling(bool adaptiveSampling) {
+      m_adaptiveSampling = adaptiveSampling;
+    }
     void draw(const AbstractPlotView *plotView, KDContext *ctx,
               KDRect rect) const;
 
@@ -103,7 +109,17 @@ class WithCurves {
      * screen though.
      */
     constexpr static int k_maxNumberOfIterations = 8;
-
+    constexpr static int k_maxStepExponent = 3;
+    /* Largest distance in pixels allowed between the curve and the chord
+     * joining two dots, when choosing adaptive steps. */
+    constexpr static float k_adaptiveSamplingTolerance = 0.5f;
+
+    // Evaluations are counted for the benchmark
+    Poincare::Coordinate2D<float> evaluate(float t) const;
+    Poincare::Coordinate2D<double> evaluateDouble(double t) const;
+    int nextStepExponent(const AbstractPlotView *plotView, int stepExponent,
+                         const float t[3],
+                         const Poincare::Coordinate2D<float> xy[3]) const;
     void joinDots(const AbstractPlotView *plotView, KDContext *ctx, KDRect rect,
                   float t1, Poincare::Coordinate2D<float> xy1, float t2,
                   Poincare::Coordinate2D<float> xy2, int remainingIterations,
@@ -127,6 +143,7 @@ class WithCurves {
     bool m_dashed;
     bool m_patternWithoutCurve;
     bool m_drawStraightLinesEarly;
+    bool m_adaptiveSampling;
   };
 
   // Methods for drawing special curves
@@ -0,0 +1,61 @@
+#include "../global_context.h"
+
+#include <poincare/function.h>
+#include <poincare/rational.h>
+#include <poincare/symbol.h>
+#include <quiz.h>
+
+#include "../../../poincare/test/helper.h"
+
+using namespace Poincare;
+
+namespace Shared {
+
+static void assert_symbol_is_defined_as(const SymbolAbstract &symbol,
+                                        const char *definition,
+                                        GlobalContext *context) {
+  Expression e = context->expressionForSymbolAbstract(symbol, true);
+  if (!definition) {
+    quiz_assert(e.isUninitialized());
+    return;
+  }
+  quiz_assert(!e.isUninitialized());
+  assert_expression_serialize_to(e, definition);
+}
+
+QUIZ_CASE(shared_global_context_memoization) {
+  GlobalContext context;
+  Symbol a = Symbol::Builder("a", 1);
+  Poincare::Function f =
+      Poincare::Function::Builder("f", 1, Rational::Builder(2));
+  assert_symbol_is_defined_as(a, nullptr, &context);
+  assert_symbol_is_defined_as(f, nullptr, &context);
+
+  // Definitions are still read after being memoized
+  assert_reduce_and_store("3→a");
+  assert_reduce_and_store("x+1→f(x)");
+  for (int i = 0; i < 2; i++) {
+    assert_symbol_is_defined_as(a, "3", &context);
+    assert_symbol_is_defined_as(f, "2+1", &context);
+  }
+
+  // Changing the storage drops the memoized definitions
+  assert_reduce_and_store("4→a");
+  assert_reduce_and_store("x+2→f(x)");
+  assert_symbol_is_defined_as(a, "4", &context);
+  assert_symbol_is_defined_as(f, "2+2", &context);
+  Ion::Storage::FileSystem::sharedFileSystem->recordNamed("f.func").destroy();
+  assert_symbol_is_defined_as(f, nullptr, &context);
+  assert_symbol_is_defined_as(a, "4", &context);
+
+  // More symbols than memoized ones can be looked up
+  const char *names[] = {"b", "c", "d", "g", "h", "k", "m", "n", "p", "q"};
+  for (const char *name : names) {
+    assert_symbol_is_defined_as(Symbol::Builder(name, 1), nullptr, &context);
+  }
+  assert_symbol_is_defined_as(a, "4", &context);
+
+  Ion::Storage::FileSystem::sharedFileSystem->destroyAllRecords();
+}
+
+}  // namespace Shared
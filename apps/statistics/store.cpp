@@ -32,6 +32,7 @@ Store::Store(GlobalContext* context, UserPreferences* userPreferences)
   for (int s = 0; s < k_numberOfSeries; s++) {
     m_datasets[s] = Poincare::StatisticsDataset<double>(&m_dataLists[s][0],
                                                         &m_dataLists[s][1]);
+    m_datasets[s].setIsMemoized();
     updateSeries(s);
   }
 }
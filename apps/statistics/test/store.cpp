@@ -1026,4 +1026,39 @@ QUIZ_CASE(data_statistics_histograms) {
   }
 }
 
+QUIZ_CASE(data_statistics_sort_column) {
+  GlobalContext context;
+  UserPreferences userPreferences;
+  Store store(&context, &userPreferences);
+
+  /* Sorting the values must keep the order of the pairs with the same value,
+   * including NaN values which go last. */
+  constexpr int numberOfPairs = 60;
+  for (int i = 0; i < numberOfPairs; i++) {
+    double value = i % 7 == 0 ? NAN : (i * 13) % 5;
+    store.set(value, k_defaultSeriesIndex, 0, i);
+    store.set(i, k_defaultSeriesIndex, 1, i);
+  }
+  store.sortColumn(k_defaultSeriesIndex, 0);
+  quiz_assert(store.numberOfPairsOfSeries(k_defaultSeriesIndex) ==
+              numberOfPairs);
+  for (int i = 1; i < numberOfPairs; i++) {
+    double previousValue = store.get(k_defaultSeriesIndex, 0, i - 1);
+    double value = store.get(k_defaultSeriesIndex, 0, i);
+    double previousRow = store.get(k_defaultSeriesIndex, 1, i - 1);
+    double row = store.get(k_defaultSeriesIndex, 1, i);
+    if (std::isnan(previousValue) || std::isnan(value)) {
+      quiz_assert(std::isnan(value));
+      quiz_assert(!std::isnan(previousValue) || previousRow < row);
+    } else {
+      quiz_assert(previousValue < value ||
+                  (previousValue == value && previousRow < row));
+    }
+    // Each value kept its row
+    quiz_assert(std::isnan(value)
+                    ? static_cast<int>(row) % 7 == 0
+                    : value == (static_cast<int>(row) * 13) % 5);
+  }
+}
+
 }  // namespace Statistics
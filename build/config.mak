@@ -14,3 +14,4 @@ ESCHER_LOG_EVENTS_BINARY ?= 0
 ESCHER_LOG_EVENTS_NAME ?= $(DEBUG)
 I18N_COMPRESS ?= 0
 ASSERTIONS ?= $(DEBUG)
+ION_COUNTERS ?= $(DEBUG)
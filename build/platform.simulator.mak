@@ -10,6 +10,14 @@ ifneq ($(findstring coverage,$(MAKECMDGOALS)),)
 COVERAGE = coverage
 endif
 
-BUILD_DIR := $(BUILD_DIR)/$(TARGET)/$(COVERAGE)
+# The benchmark reports the Ion counters, which are compiled out of the other
+# builds, so it is built in its own directory.
+BENCHMARK =
+ifneq ($(findstring benchmark,$(MAKECMDGOALS)),)
+BENCHMARK = benchmark/
+ION_COUNTERS = 1
+endif
+
+BUILD_DIR := $(BUILD_DIR)/$(TARGET)/$(COVERAGE)$(BENCHMARK)
 
 include build/platform.simulator.$(TARGET).mak
@@ -11,3 +11,12 @@ reload: default
 # If MICROPY_NLR_SETJMP is 0, the MicroPython NLR done by
 # python/src/py/nlrx64.c crashes on linux.
 SFLAGS += -DMICROPY_NLR_SETJMP=1
+
+# Replay the benchmark scenarios and write their timings as JSON
+BENCHMARK_ITERATIONS ?= 5
+BENCHMARK_SCENARI ?= $(wildcard tests/benchmark_scenari/*.nws)
+
+.PHONY: benchmark
+benchmark: $(BUILD_DIR)/epsilon.$(EXE)
+	$(call rule_label,BENCH)
+	$(Q) ./$< --headless $(addprefix --benchmark ,$(BENCHMARK_SCENARI)) --benchmark-iterations $(BENCHMARK_ITERATIONS) --benchmark-output $(BUILD_DIR)/benchmark.json
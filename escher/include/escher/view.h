@@ -93,7 +93,25 @@ class View {
   void setFrame(KDRect frame, bool force);
   virtual void layoutSubviews(bool force = false) {}
   void translate(KDPoint origin);
-  KDRect redraw(KDRect rect, KDRect forceRedrawRect = KDRectZero);
+  /* A few rectangles, which are merged when their bounding box is not much
+   * bigger than them. */
+  class Region {
+   public:
+    Region()
+        : m_rects{KDRectZero, KDRectZero, KDRectZero, KDRectZero},
+          m_numberOfRects(0) {}
+    void add(KDRect rect);
+    void add(const Region &region);
+    // Bounding box of the parts of the rectangles inside rect
+    KDRect boundsWithin(KDRect rect) const;
+
+   private:
+    constexpr static int k_maxNumberOfRects = 4;
+    KDRect m_rects[k_maxNumberOfRects];
+    int m_numberOfRects;
+  };
+
+  Region redraw(KDRect rect, const Region &forceRedrawRegion = Region());
 
   /* At destruction, subviews aren't notified that their own pointer
    * 'm_superview' is outdated. This is not an issue since all view hierarchy
@@ -1,4 +1,5 @@
 #include <escher/view.h>
+#include <ion/counters.h>
 #include <kandinsky/ion_context.h>
 
 extern "C" {
@@ -13,37 +14,84 @@ void View::markRectAsDirty(KDRect rect) {
   markAbsoluteRectAsDirty(rect.translatedBy(m_frame.origin()));
 }
 
+static Ion::Counters::Counter s_redrawnPixels("redrawn_pixels");
+
+static uint32_t Area(KDRect rect) {
+  return static_cast<uint32_t>(rect.width()) * rect.height();
+}
+
+/* Keeping rectangles apart only pays when their bounding box is much bigger
+ * than them, as for a cell and the title bar battery. */
+static bool ShouldMergeRects(KDRect r1, KDRect r2) {
+  return r1.isEmpty() || r2.isEmpty() ||
+         Area(r1.unionedWith(r2)) <= 2 * (Area(r1) + Area(r2));
+}
+
 void View::markAbsoluteRectAsDirty(KDRect rect) {
   /* Intersect with m_frame before unioning to avoid KDCoordinate overflow. */
   m_dirtyRect = m_dirtyRect.intersectedWith(m_frame).unionedWith(
       rect.intersectedWith(m_frame));
 }
 
-KDRect View::redraw(KDRect rect, KDRect forceRedrawRect) {
+void View::Region::add(KDRect rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  for (int i = 0; i < m_numberOfRects; i++) {
+    if (ShouldMergeRects(m_rects[i], rect)) {
+      m_rects[i] = m_rects[i].unionedWith(rect);
+      return;
+    }
+  }
+  if (m_numberOfRects < k_maxNumberOfRects) {
+    m_rects[m_numberOfRects++] = rect;
+    return;
+  }
+  m_rects[k_maxNumberOfRects - 1] =
+      m_rects[k_maxNumberOfRects - 1].unionedWith(rect);
+}
+
+void View::Region::add(const Region &region) {
+  for (int i = 0; i < region.m_numberOfRects; i++) {
+    add(region.m_rects[i]);
+  }
+}
+
+KDRect View::Region::boundsWithin(KDRect rect) const {
+  KDRect result = KDRectZero;
+  for (int i = 0; i < m_numberOfRects; i++) {
+    result = result.unionedWith(m_rects[i].intersectedWith(rect));
+  }
+  return result;
+}
+
+View::Region View::redraw(KDRect rect, const Region &forceRedrawRegion) {
   /* View::redraw recursively redraws the rectangle 'rect' of the view and all
    * its subviews.
    * To optimize the function, we redraw only the union of the current dirty
-   * rectangle with a rectangle forced to be redrawn (forceRedrawRect). This
-   * rectangle is initially empty and recursively expands by unioning with the
+   * rectangle with a region forced to be redrawn (forceRedrawRegion). This
+   * region is initially empty and recursively expands by adding the
    * rectangles that are redrawn. This process handles the case when several
    * sister views are overlapping (provided that the sister views are indexed in
-   * the right order).
+   * the right order). Keeping distant redrawn rectangles apart in the region
+   * avoids redrawing the sister views lying between them.
    */
 
   /* First, for the current view, the rectangle to redraw is the union of the
-   * dirty rectangle and the rectangle forced to be redrawn. The rectangle to
+   * dirty rectangle and the region forced to be redrawn. The rectangle to
    * redraw must also be included in the current view bounds and in the
    * rectangle rect. */
   if (rect.isEmpty()) {
-    return KDRectZero;
+    return Region();
   }
   KDRect visibleRect = rect.intersectedWith(m_frame);
   KDRect rectNeedingRedraw =
       visibleRect.intersectedWith(m_dirtyRect)
-          .unionedWith(forceRedrawRect.intersectedWith(m_frame));
+          .unionedWith(forceRedrawRegion.boundsWithin(m_frame));
 
   // This redraws the rectNeedingRedraw calling drawRect.
   if (!rectNeedingRedraw.isEmpty()) {
+    s_redrawnPixels.add(Area(rectNeedingRedraw));
     KDPoint absOrigin = absoluteOrigin();
     KDContext *ctx = KDIonContext::SharedContext;
     ctx->setOrigin(absOrigin);
@@ -51,7 +99,8 @@ KDRect View::redraw(KDRect rect, KDRect forceRedrawRect) {
     drawRect(ctx, rectNeedingRedraw.relativeTo(m_frame.origin()));
   }
   // This initializes the area that has been redrawn.
-  KDRect redrawnArea = rectNeedingRedraw;
+  Region redrawnArea;
+  redrawnArea.add(rectNeedingRedraw);
 
   // Then, let's recursively draw our children over ourself
   uint8_t subviewsNumber = numberOfSubviews();
@@ -61,12 +110,12 @@ KDRect View::redraw(KDRect rect, KDRect forceRedrawRect) {
       continue;
     }
 
-    /* We redraw the current subview by passing the rectangle previously redrawn
+    /* We redraw the current subview by passing the region previously redrawn
      * (by the parent view or previous sister views) as forced to be redraw. */
-    KDRect subviewRedrawnArea = subview->redraw(visibleRect, redrawnArea);
+    Region subviewRedrawnArea = subview->redraw(visibleRect, redrawnArea);
 
     // We expand the redrawn area to include the area just drawn.
-    redrawnArea = redrawnArea.unionedWith(subviewRedrawnArea);
+    redrawnArea.add(subviewRedrawnArea);
   }
   // Eventually, mark that we don't need to be redrawn
   m_dirtyRect = KDRectZero;
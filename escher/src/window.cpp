@@ -1,5 +1,6 @@
 #include <escher/window.h>
 #include <ion.h>
+#include <kandinsky/ion_context.h>
 extern "C" {
 #include <assert.h>
 }
@@ -11,7 +12,9 @@ void Window::redraw(bool force) {
     markWholeFrameAsDirty();
   }
   Ion::Display::waitForVBlank();
+  KDIonContext::SharedContext->startRecording();
   View::redraw(bounds());
+  KDIonContext::SharedContext->stopRecording();
 }
 
 void Window::setContentView(View* contentView) {
@@ -0,0 +1,17 @@
+#include <escher/solid_color_view.h>
+#include <escher/window.h>
+#include <kandinsky/ion_context.h>
+#include <quiz.h>
+
+using namespace Escher;
+
+QUIZ_CASE(escher_window_redraw_stops_recording) {
+  SolidColorView view(KDColorRed);
+  Window window;
+  window.setAbsoluteFrame(KDRect(0, 0, 10, 10));
+  window.setContentView(&view);
+  window.redraw(true);
+  /* Uniform fills are only recorded during the redraw, later fills are pushed
+   * directly. */
+  quiz_assert(!KDIonContext::SharedContext->isRecording());
+}
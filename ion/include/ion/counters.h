@@ -0,0 +1,57 @@
+#ifndef ION_COUNTERS_H
+#define ION_COUNTERS_H
+
+#include <stdint.h>
+
+namespace Ion {
+namespace Counters {
+
+/* A Counter measures some work done by the modules above Ion, such as the
+ * number of evaluations needed to draw a curve. Counters are meant to be
+ * static objects: they are linked in a list the first time they are
+ * incremented, so that the simulator benchmark can report all of them for each
+ * scenario without knowing them. Counting is compiled out unless ION_COUNTERS
+ * is set, which debug and benchmark builds do. */
+
+class Counter {
+ public:
+  constexpr Counter(const char* name)
+      : m_name(name), m_value(0), m_next(nullptr), m_registered(false) {}
+
+  const char* name() const { return m_name; }
+  uint32_t value() const { return m_value; }
+  Counter* next() const { return m_next; }
+
+  void add(uint32_t n = 1) {
+#if ION_COUNTERS
+    if (!m_registered) {
+      m_next = s_firstCounter;
+      s_firstCounter = this;
+      m_registered = true;
+    }
+    m_value += n;
+#endif
+  }
+  void reset() { m_value = 0; }
+
+  // Counters that have been incremented at least once
+  static Counter* First() { return s_firstCounter; }
+  static void ResetAll() {
+    for (Counter* c = s_firstCounter; c != nullptr; c = c->m_next) {
+      c->reset();
+    }
+  }
+
+ private:
+  inline static Counter* s_firstCounter = nullptr;
+
+  const char* m_name;
+  uint32_t m_value;
+  Counter* m_next;
+  bool m_registered;
+};
+
+}  // namespace Counters
+}  // namespace Ion
+
+#endif
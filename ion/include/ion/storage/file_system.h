@@ -47,6 +47,18 @@ class FileSystem {
   void setDelegate(StorageDelegate *delegate) { m_delegate = delegate; }
   void notifyChangeToDelegate(const Record r = Record()) const;
   Record::ErrorStatus notifyFullnessToDelegate() const;
+  /* Incremented by each change notification, so that values derived from the
+   * records can be memoized as long as the version is unchanged. */
+  uint32_t version() const { return m_version; }
+  /* Forget the index and the positions and counts memoized from the buffer,
+   * and increment the version. Must be called when the buffer is written from
+   * outside of the FileSystem, for instance by the host during DFU. */
+  void invalidateMemoization() const;
+  /* Values of variables in a storage written with RawValuesMagic do not start
+   * with their ValueFormat. Prefix them with ValueFormat::Raw, destroying the
+   * records that cannot grow anymore, and switch to the current Magic. Must be
+   * called when the buffer is written from outside of the FileSystem. */
+  void upgradeValueFormat();
 
   // Record name verifier
   RecordNameVerifier *recordNameVerifier() { return &m_recordNameVerifier; }
@@ -59,7 +71,7 @@ class FileSystem {
   int numberOfRecordsStartingWithout(const char nonStartingChar,
                                      const char *extension) {
     return numberOfRecordsWithFilter(extension, FirstCharFilter,
-                                     &nonStartingChar);
+                                     nonStartingChar);
   }
 
   // Record names helper
@@ -88,7 +100,39 @@ class FileSystem {
                                                    const char *extension,
                                                    int index) {
     return recordWithFilterAtIndex(extension, index, FirstCharFilter,
-                                   &nonStartingChar);
+                                   nonStartingChar);
+  }
+  /* Enumerate the records of an extension in a single pass over the buffer:
+   *   for (Record r : sharedFileSystem->recordsWithExtension(extension))
+   * Record values can be edited in place, but no record can be created,
+   * destroyed, renamed or resized during the enumeration. */
+  class RecordsWithExtension {
+   public:
+    class Iterator {
+     public:
+      Iterator(char *recordStart, const char *extension);
+      Record operator*() const;
+      Iterator &operator++();
+      bool operator!=(const Iterator &it) const {
+        return m_recordStart != it.m_recordStart;
+      }
+
+     private:
+      void skipRecordsWithOtherExtensions();
+      char *m_recordStart;
+      const char *m_extension;
+    };
+    RecordsWithExtension(char *firstRecord, const char *extension)
+        : m_firstRecord(firstRecord), m_extension(extension) {}
+    Iterator begin() const { return Iterator(m_firstRecord, m_extension); }
+    Iterator end() const { return Iterator(nullptr, m_extension); }
+
+   private:
+    char *m_firstRecord;
+    const char *m_extension;
+  };
+  RecordsWithExtension recordsWithExtension(const char *extension) {
+    return RecordsWithExtension(*begin(), extension);
   }
   Record recordNamed(Record::Name name);
   Record recordNamed(const char *fullName) {
@@ -122,24 +166,24 @@ class FileSystem {
                              bool notifyDelegate = true);
 
  private:
-  constexpr static uint32_t Magic = 0xEE0BDDBA;
+  constexpr static uint32_t Magic = 0xEE0BDDBB;
+  // Magic of storages written before values had a ValueFormat
+  constexpr static uint32_t RawValuesMagic = 0xEE0BDDBA;
   constexpr static size_t k_maxRecordSize = (1 << sizeof(record_size_t) * 8);
 
   // Record filter on names
-  typedef bool (*RecordFilter)(Record::Name name, const void *auxiliary);
-  static bool ExtensionOnlyFilter(Record::Name name, const void *auxiliary) {
+  typedef bool (*RecordFilter)(Record::Name name, char auxiliary);
+  static bool ExtensionOnlyFilter(Record::Name name, char auxiliary) {
     return true;
   };
-  static bool FirstCharFilter(Record::Name name, const void *auxiliary) {
-    assert(auxiliary);
-    return name.baseName[0] != *static_cast<const char *>(auxiliary);
+  static bool FirstCharFilter(Record::Name name, char auxiliary) {
+    return name.baseName[0] != auxiliary;
   };
   // Private record counters and getters
   int numberOfRecordsWithFilter(const char *extension, RecordFilter filter,
-                                const void *auxiliary = nullptr);
+                                char auxiliary = 0);
   Record recordWithFilterAtIndex(const char *extension, int index,
-                                 RecordFilter filter,
-                                 const void *auxiliary = nullptr);
+                                 RecordFilter filter, char auxiliary = 0);
 
   FileSystem();
 
@@ -186,6 +230,78 @@ class FileSystem {
   };
   RecordIterator end() const { return RecordIterator(nullptr); }
 
+  /* recordWithFilterAtIndex remembers where it found its last record, so that
+   * iterating over the records of an extension by index does not restart from
+   * the first record every time. numberOfRecordsWithFilter remembers its last
+   * count. Both are forgotten along with the index below. */
+  class MemoizedFilter {
+   public:
+    MemoizedFilter() { forget(); }
+    bool matches(const char *extension, RecordFilter filter,
+                 char auxiliary) const {
+      return m_extension[0] != 0 && strcmp(m_extension, extension) == 0 &&
+             m_filter == filter && m_auxiliary == auxiliary;
+    }
+    void set(const char *extension, RecordFilter filter, char auxiliary);
+    void forget() { m_extension[0] = 0; }
+
+   private:
+    // Longer extensions are not memoized
+    constexpr static size_t k_extensionSize = 8;
+    char m_extension[k_extensionSize];
+    RecordFilter m_filter;
+    char m_auxiliary;
+  };
+
+  /* Records are indexed in two open addressing hash tables, so that looking a
+   * record up does not walk the whole buffer: one is addressed by the CRC32 of
+   * the full names, the other by a hash of the base names. The index is built
+   * lazily and invalidated whenever records are moved or renamed. Only the
+   * first k_maxNumberOfIndexedRecords records are indexed, the following ones
+   * are still looked up linearly. */
+  constexpr static int k_indexCapacity = 256;
+  constexpr static int k_maxNumberOfIndexedRecords = k_indexCapacity / 2;
+  static_assert((k_indexCapacity & (k_indexCapacity - 1)) == 0,
+                "k_indexCapacity should be a power of 2");
+  constexpr static record_size_t k_emptySlot = UINT16_MAX;
+  static_assert(k_emptySlot >= k_storageSize,
+                "k_emptySlot should not be a valid offset");
+  static int FirstSlot(uint32_t hash) { return hash & (k_indexCapacity - 1); }
+  static int NextSlot(int slot) { return (slot + 1) & (k_indexCapacity - 1); }
+  static uint32_t BaseNameHash(const char *baseName, size_t baseNameLength);
+  void invalidateIndex() const {
+    m_numberOfIndexedRecords = -1;
+    m_cursorFilter.forget();
+    m_countFilter.forget();
+  }
+  void buildIndex() const;
+  char *indexedPointerOfRecord(const Record record) const;
+  RecordIterator beginUnindexedRecords() const;
+
+  /* Values of variables (expressions, lists and matrices) start with their
+   * ValueFormat. Values of k_minSizeOfCompressedValue bytes or more are stored
+   * as an LZ4 block following their size, if it saves space and if they fit in
+   * m_decompressionBuffer. Reading a compressed value decompresses it in
+   * m_decompressionBuffer, where it remains until the value of another
+   * compressed record is read. While a value is compressed, the buffer holds
+   * the LZ4 state, followed by the compressed value. */
+  enum class ValueFormat : uint8_t { Raw = 0, LZ4 = 1 };
+  constexpr static size_t k_compressedValueHeaderSize =
+      sizeof(ValueFormat) + sizeof(record_size_t);
+  constexpr static size_t k_minSizeOfCompressedValue = 128;
+  // Holds a column of 100 list elements
+  constexpr static size_t k_decompressionBufferSize = 2560;
+  // Size of the LZ4 state with LZ4_MEMORY_USAGE=10
+  constexpr static size_t k_compressionStateSize = 1056;
+  static bool ValueIsFormatted(const char *extension);
+  /* Writes the compressed value of data in m_decompressionBuffer after the
+   * LZ4 state and returns its size, or 0 if data is not worth compressing. */
+  size_t compressValue(const void *data, size_t size);
+  Record::Data decodeValue(Record record, const char *value, size_t size);
+  size_t writeValue(char *position, bool formatted, size_t compressedSize,
+                    const void *dataChunks[], size_t sizeChunks[],
+                    size_t numberOfChunks);
+
   Record privateRecordBasedNamedWithExtensions(
       const char *baseName, int baseNameLength, const char *const extensions[],
       size_t numberOfExtensions, const char **extensionResult = nullptr);
@@ -201,6 +317,24 @@ class FileSystem {
   RecordNameVerifier m_recordNameVerifier;
   mutable Record m_lastRecordRetrieved;
   mutable char *m_lastRecordRetrievedPointer;
+  // A null checksum marks an empty slot, null records are never indexed
+  mutable uint32_t m_checksumIndexKeys[k_indexCapacity];
+  mutable record_size_t m_checksumIndexOffsets[k_indexCapacity];
+  mutable record_size_t m_baseNameIndexOffsets[k_indexCapacity];
+  // Offset of the first record which is not indexed, or of the end of buffer
+  mutable record_size_t m_firstUnindexedRecordOffset;
+  // -1 when the index needs to be rebuilt
+  mutable int m_numberOfIndexedRecords;
+  mutable MemoizedFilter m_cursorFilter;
+  mutable int m_cursorIndex;
+  mutable record_size_t m_cursorOffset;
+  mutable MemoizedFilter m_countFilter;
+  mutable int m_count;
+  mutable uint32_t m_version;
+  alignas(8) char m_decompressionBuffer[k_decompressionBufferSize];
+  // Record decompressed in m_decompressionBuffer, at version m_version
+  Record m_decompressedRecord;
+  uint32_t m_decompressedVersion;
 };
 
 }  // namespace Storage
@@ -24,6 +24,8 @@ constexpr static char regExtension[] = "reg";
  *   Keeping a buffer with the fullNames will waste memory as we cannot
  *   forsee the size of the fullNames. */
 class Record {
+  friend class FileSystem;
+
  public:
   constexpr static char k_dotChar = '.';
   enum class ErrorStatus {
@@ -60,6 +62,9 @@ class Record {
   bool isNull() const { return m_fullNameCRC32 == 0; }
   Name name() const;
   const char* fullName() const;
+  /* The value of a compressed record is decompressed in a buffer shared by
+   * all records: it remains valid only until the value of another compressed
+   * record is read, or until the storage is modified. */
   Data value() const;
   ErrorStatus setValue(Data data);
   /* destroy asserts that the record can be destroyed while tryToDestroy returns
@@ -28,6 +28,9 @@ class Scenario {
   int m_numberOfEvents;
 };
 
+/* These scenarios are also available as state files in tests/benchmark_scenari
+ * for the simulator benchmark (see ion/src/simulator/shared/benchmark.h). */
+
 constexpr static Event scenarioCalculation[] = {
     OK, Pi, Plus, One, Division, Two, OK,   OK,   Sqrt, Zero, Dot,  Two,
     OK, OK, Up,   Up,  Up,       Up,  Down, Down, Down, Down, Home, Home};
@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <ion.h>
+#include <ion/counters.h>
 #include <poincare/integer.h>
 #include <string.h>
 
@@ -8,12 +9,21 @@
 #include <iostream>
 #endif
 
+#include "../../external/lz4/lz4.h"
+
 namespace Ion {
 
 namespace Storage {
 
 OMG::GlobalBox<FileSystem> FileSystem::sharedFileSystem;
 
+static Ion::Counters::Counter s_scannedRecords("storage_scanned_records");
+static Ion::Counters::Counter s_compressionInputBytes(
+    "storage_compression_input_bytes");
+static Ion::Counters::Counter s_compressionOutputBytes(
+    "storage_compression_output_bytes");
+static Ion::Counters::Counter s_decompressedBytes("storage_decompressed_bytes");
+
 // STORAGE
 
 #if ION_STORAGE_LOG
@@ -59,9 +69,43 @@ uint32_t FileSystem::checksum() {
   return Ion::crc32Byte((const uint8_t *)m_buffer, endBuffer() - m_buffer);
 }
 
-void FileSystem::notifyChangeToDelegate(const Record record) const {
+void FileSystem::invalidateMemoization() const {
   m_lastRecordRetrieved = Record(nullptr);
   m_lastRecordRetrievedPointer = nullptr;
+  invalidateIndex();
+  m_version++;
+}
+
+void FileSystem::upgradeValueFormat() {
+  if (m_magicHeader != RawValuesMagic) {
+    return;
+  }
+  char *p = m_buffer;
+  record_size_t size;
+  while ((size = sizeOfRecordStarting(p)) != 0) {
+    Record::Name name = nameOfRecordStarting(p);
+    if (!ValueIsFormatted(name.extension)) {
+      p += size;
+      continue;
+    }
+    char *value = p + sizeof(record_size_t) + Record::SizeOfName(name);
+    size_t newSize = size + sizeof(ValueFormat);
+    if (newSize < k_maxRecordSize && slideBuffer(value, sizeof(ValueFormat))) {
+      value[0] = static_cast<char>(ValueFormat::Raw);
+      overrideSizeAtPosition(p, newSize);
+      p += newSize;
+    } else {
+      // Destroy the record rather than read its value with an offset
+      slideBuffer(p + size, -size);
+    }
+  }
+  m_magicHeader = Magic;
+  m_magicFooter = Magic;
+  notifyChangeToDelegate();
+}
+
+void FileSystem::notifyChangeToDelegate(const Record record) const {
+  invalidateMemoization();
   if (m_delegate) {
     m_delegate->storageDidChangeForRecord(record);
   }
@@ -128,7 +172,15 @@ Record::ErrorStatus FileSystem::createRecordWithDataChunks(
   for (size_t i = 0; i < numberOfChunks; i++) {
     totalSize += sizeChunks[i];
   }
-  size_t recordSize = sizeOfRecordWithName(recordName, totalSize);
+  bool formatted = ValueIsFormatted(recordName.extension);
+  size_t compressedSize = formatted && numberOfChunks == 1
+                              ? compressValue(dataChunks[0], totalSize)
+                              : 0;
+  size_t valueSize =
+      compressedSize > 0
+          ? compressedSize
+          : totalSize + (formatted ? sizeof(ValueFormat) : 0);
+  size_t recordSize = sizeOfRecordWithName(recordName, valueSize);
   Record recordWithSameName(recordName);
   /* pointerOfRecord will find the record with same name in the FileSystem.
    * If the record does not already exist, pointerOfRecord == nullptr and
@@ -168,10 +220,8 @@ Record::ErrorStatus FileSystem::createRecordWithDataChunks(
   // Fill name
   newRecord += overrideNameAtPosition(newRecord, recordName);
   // Fill data
-  for (size_t i = 0; i < numberOfChunks; i++) {
-    newRecord +=
-        overrideValueAtPosition(newRecord, dataChunks[i], sizeChunks[i]);
-  }
+  newRecord += writeValue(newRecord, formatted, compressedSize, dataChunks,
+                          sizeChunks, numberOfChunks);
   // Next Record is null-sized
   overrideSizeAtPosition(newRecord, 0);
   Record r = Record(recordName);
@@ -183,7 +233,10 @@ Record::ErrorStatus FileSystem::createRecordWithDataChunks(
 
 int FileSystem::numberOfRecordsWithFilter(const char *extension,
                                           RecordFilter filter,
-                                          const void *auxiliary) {
+                                          char auxiliary) {
+  if (m_countFilter.matches(extension, filter, auxiliary)) {
+    return m_count;
+  }
   int count = 0;
   for (char *p : *this) {
     Record::Name currentName = nameOfRecordStarting(p);
@@ -193,35 +246,39 @@ int FileSystem::numberOfRecordsWithFilter(const char *extension,
       count++;
     }
   }
+  m_countFilter.set(extension, filter, auxiliary);
+  m_count = count;
   return count;
 }
 
 Record FileSystem::recordWithFilterAtIndex(const char *extension, int index,
                                            RecordFilter filter,
-                                           const void *auxiliary) {
+                                           char auxiliary) {
   int currentIndex = -1;
-  Record::Name name = Record::EmptyName();
-  char *recordAddress = nullptr;
-  for (char *p : *this) {
+  RecordIterator it = begin();
+  if (m_cursorFilter.matches(extension, filter, auxiliary) &&
+      m_cursorIndex <= index) {
+    // Resume from the last record found, which is at index m_cursorIndex
+    currentIndex = m_cursorIndex - 1;
+    it = RecordIterator(m_buffer + m_cursorOffset);
+  }
+  for (; it != end(); ++it) {
+    char *p = *it;
     Record::Name currentName = nameOfRecordStarting(p);
     assert(currentName.extension);
     if (!Record::NameIsEmpty(currentName) && filter(currentName, auxiliary) &&
-        strcmp(currentName.extension, extension) == 0) {
-      currentIndex++;
-    }
-    if (currentIndex == index) {
-      recordAddress = p;
-      name = currentName;
-      break;
+        strcmp(currentName.extension, extension) == 0 &&
+        ++currentIndex == index) {
+      m_cursorFilter.set(extension, filter, auxiliary);
+      m_cursorIndex = index;
+      m_cursorOffset = p - m_buffer;
+      Record r = Record(currentName);
+      m_lastRecordRetrieved = r;
+      m_lastRecordRetrievedPointer = p;
+      return r;
     }
   }
-  if (Record::NameIsEmpty(name)) {
-    return Record();
-  }
-  Record r = Record(name);
-  m_lastRecordRetrieved = r;
-  m_lastRecordRetrievedPointer = recordAddress;
-  return Record(name);
+  return Record();
 }
 
 Record FileSystem::recordNamed(Record::Name name) {
@@ -317,7 +374,16 @@ FileSystem::FileSystem()
       m_magicFooter(Magic),
       m_delegate(nullptr),
       m_lastRecordRetrieved(nullptr),
-      m_lastRecordRetrievedPointer(nullptr) {
+      m_lastRecordRetrievedPointer(nullptr),
+      m_firstUnindexedRecordOffset(0),
+      m_numberOfIndexedRecords(-1),
+      m_cursorIndex(0),
+      m_cursorOffset(0),
+      m_count(0),
+      m_version(0),
+      m_decompressionBuffer(),
+      m_decompressedRecord(),
+      m_decompressedVersion(0) {
   assert(m_magicHeader == Magic);
   assert(m_magicFooter == Magic);
   // Set the size of the first record to 0
@@ -379,8 +445,11 @@ Record::Data FileSystem::valueOfRecord(const Record record) {
     Record::Name name = nameOfRecordStarting(p);
     record_size_t size = sizeOfRecordStarting(p);
     const void *value = valueOfRecordStarting(p);
-    return {.buffer = value,
-            .size = size - Record::SizeOfName(name) - sizeof(record_size_t)};
+    size_t valueSize = size - Record::SizeOfName(name) - sizeof(record_size_t);
+    if (ValueIsFormatted(name.extension)) {
+      return decodeValue(record, static_cast<const char *>(value), valueSize);
+    }
+    return {.buffer = value, .size = valueSize};
   }
   return {.buffer = nullptr, .size = 0};
 }
@@ -398,7 +467,14 @@ Record::ErrorStatus FileSystem::setValueOfRecord(Record record,
     }
     record_size_t previousRecordSize = sizeOfRecordStarting(p);
     Record::Name name = nameOfRecordStarting(p);
-    size_t newRecordSize = sizeOfRecordWithName(name, data.size);
+    bool formatted = ValueIsFormatted(name.extension);
+    size_t compressedSize =
+        formatted ? compressValue(data.buffer, data.size) : 0;
+    size_t valueSize =
+        compressedSize > 0
+            ? compressedSize
+            : data.size + (formatted ? sizeof(ValueFormat) : 0);
+    size_t newRecordSize = sizeOfRecordWithName(name, valueSize);
     if (newRecordSize >= k_maxRecordSize ||
         !slideBuffer(p + previousRecordSize,
                      newRecordSize - previousRecordSize)) {
@@ -406,8 +482,10 @@ Record::ErrorStatus FileSystem::setValueOfRecord(Record record,
     }
     record_size_t nameSize = Record::SizeOfName(name);
     overrideSizeAtPosition(p, newRecordSize);
-    overrideValueAtPosition(p + sizeof(record_size_t) + nameSize, data.buffer,
-                            data.size);
+    const void *dataChunks[] = {data.buffer};
+    size_t sizeChunks[] = {data.size};
+    writeValue(p + sizeof(record_size_t) + nameSize, formatted, compressedSize,
+               dataChunks, sizeChunks, 1);
     notifyChangeToDelegate(record);
     m_lastRecordRetrieved = record;
     m_lastRecordRetrievedPointer = p;
@@ -442,17 +520,86 @@ char *FileSystem::pointerOfRecord(const Record record) const {
     assert(m_lastRecordRetrievedPointer);
     return m_lastRecordRetrievedPointer;
   }
+  char *p = indexedPointerOfRecord(record);
+  if (p) {
+    m_lastRecordRetrieved = record;
+    m_lastRecordRetrievedPointer = p;
+  }
+  return p;
+}
+
+uint32_t FileSystem::BaseNameHash(const char *baseName,
+                                  size_t baseNameLength) {
+  // FNV-1a, much cheaper than a CRC32 computed byte per byte
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < baseNameLength; i++) {
+    hash = (hash ^ static_cast<uint8_t>(baseName[i])) * 16777619u;
+  }
+  return hash;
+}
+
+void FileSystem::buildIndex() const {
+  memset(m_checksumIndexKeys, 0, sizeof(m_checksumIndexKeys));
+  memset(m_baseNameIndexOffsets, 0xFF, sizeof(m_baseNameIndexOffsets));
+  static_assert(k_emptySlot == 0xFFFF, "memset fills slots with k_emptySlot");
+  m_numberOfIndexedRecords = 0;
+  char *nextRecord = const_cast<char *>(m_buffer);
   for (char *p : *this) {
-    Record currentRecord(nameOfRecordStarting(p));
-    if (record == currentRecord) {
-      m_lastRecordRetrieved = record;
-      m_lastRecordRetrievedPointer = p;
+    if (m_numberOfIndexedRecords == k_maxNumberOfIndexedRecords) {
+      break;
+    }
+    s_scannedRecords.add();
+    nextRecord = p + sizeOfRecordStarting(p);
+    Record::Name name = nameOfRecordStarting(p);
+    Record record(name);
+    if (record.isNull()) {
+      continue;
+    }
+    record_size_t offset = p - m_buffer;
+    int slot = FirstSlot(record.m_fullNameCRC32);
+    while (m_checksumIndexKeys[slot] != 0) {
+      slot = NextSlot(slot);
+    }
+    m_checksumIndexKeys[slot] = record.m_fullNameCRC32;
+    m_checksumIndexOffsets[slot] = offset;
+    slot = FirstSlot(BaseNameHash(name.baseName, name.baseNameLength));
+    while (m_baseNameIndexOffsets[slot] != k_emptySlot) {
+      slot = NextSlot(slot);
+    }
+    m_baseNameIndexOffsets[slot] = offset;
+    m_numberOfIndexedRecords++;
+  }
+  m_firstUnindexedRecordOffset = nextRecord - m_buffer;
+}
+
+char *FileSystem::indexedPointerOfRecord(const Record record) const {
+  assert(!record.isNull());
+  if (m_numberOfIndexedRecords < 0) {
+    buildIndex();
+  }
+  for (int slot = FirstSlot(record.m_fullNameCRC32);
+       m_checksumIndexKeys[slot] != 0; slot = NextSlot(slot)) {
+    if (m_checksumIndexKeys[slot] == record.m_fullNameCRC32) {
+      char *p = const_cast<char *>(m_buffer) + m_checksumIndexOffsets[slot];
+      assert(Record(nameOfRecordStarting(p)) == record);
       return p;
     }
   }
+  for (RecordIterator it = beginUnindexedRecords(); it != end(); ++it) {
+    s_scannedRecords.add();
+    if (Record(nameOfRecordStarting(*it)) == record) {
+      return *it;
+    }
+  }
   return nullptr;
 }
 
+FileSystem::RecordIterator FileSystem::beginUnindexedRecords() const {
+  assert(m_numberOfIndexedRecords >= 0);
+  char *p = const_cast<char *>(m_buffer) + m_firstUnindexedRecordOffset;
+  return RecordIterator(sizeOfRecordStarting(p) == 0 ? nullptr : p);
+}
+
 FileSystem::record_size_t FileSystem::sizeOfRecordStarting(char *start) const {
   return start ? StorageHelper::unalignedShort(start) : 0;
 }
@@ -473,11 +620,13 @@ Record::Name FileSystem::nameOfRecordStarting(char *start) const {
 }
 
 size_t FileSystem::overrideSizeAtPosition(char *position, record_size_t size) {
+  invalidateIndex();
   StorageHelper::writeUnalignedShort(size, position);
   return sizeof(record_size_t);
 }
 
 size_t FileSystem::overrideNameAtPosition(char *position, Record::Name name) {
+  invalidateIndex();
   memcpy(position, name.baseName, name.baseNameLength);
   position += name.baseNameLength;
   assert(UTF8Decoder::CharSizeOfCodePoint(Record::k_dotChar) == 1);
@@ -496,6 +645,100 @@ size_t FileSystem::overrideValueAtPosition(char *position, const void *data,
   return size;
 }
 
+bool FileSystem::ValueIsFormatted(const char *extension) {
+  return strcmp(extension, expExtension) == 0 ||
+         strcmp(extension, lisExtension) == 0 ||
+         strcmp(extension, matExtension) == 0;
+}
+
+size_t FileSystem::compressValue(const void *data, size_t size) {
+  const char *source = static_cast<const char *>(data);
+  if (size < k_minSizeOfCompressedValue || size > k_decompressionBufferSize ||
+      (source < m_decompressionBuffer + k_decompressionBufferSize &&
+       source + size > m_decompressionBuffer)) {
+    return 0;
+  }
+  // The buffer is overwritten even if the compression fails
+  m_decompressedRecord = Record();
+  static_assert(sizeof(LZ4_stream_t) <= k_compressionStateSize &&
+                    alignof(LZ4_stream_t) <= 8,
+                "The LZ4 state does not fit in the decompression buffer");
+  // lz4.c must be built with the same LZ4_MEMORY_USAGE as this file
+  assert(LZ4_sizeofState() == sizeof(LZ4_stream_t));
+  LZ4_stream_t *state = reinterpret_cast<LZ4_stream_t *>(m_decompressionBuffer);
+  char *compressedValue = m_decompressionBuffer + k_compressionStateSize;
+  /* The capacity is chosen so that the compressed value is smaller than the
+   * raw one, and fits after the state. */
+  size_t capacity =
+      (size < k_decompressionBufferSize - k_compressionStateSize
+           ? size
+           : k_decompressionBufferSize - k_compressionStateSize) -
+      k_compressedValueHeaderSize;
+  int blockSize = LZ4_compress_fast_extState(
+      state, source, compressedValue + k_compressedValueHeaderSize, size,
+      capacity, 1);
+  if (blockSize <= 0) {
+    return 0;
+  }
+  compressedValue[0] = static_cast<char>(ValueFormat::LZ4);
+  StorageHelper::writeUnalignedShort(size, compressedValue + 1);
+  size_t compressedSize = k_compressedValueHeaderSize + blockSize;
+  s_compressionInputBytes.add(size);
+  s_compressionOutputBytes.add(compressedSize);
+  return compressedSize;
+}
+
+Record::Data FileSystem::decodeValue(Record record, const char *value,
+                                     size_t size) {
+  if (size == 0) {
+    return {.buffer = value, .size = 0};
+  }
+  if (static_cast<ValueFormat>(value[0]) == ValueFormat::Raw) {
+    return {.buffer = value + sizeof(ValueFormat),
+            .size = size - sizeof(ValueFormat)};
+  }
+  // Corrupted values are read as empty values
+  if (static_cast<ValueFormat>(value[0]) != ValueFormat::LZ4 ||
+      size < k_compressedValueHeaderSize) {
+    return {.buffer = value, .size = 0};
+  }
+  size_t decompressedSize =
+      StorageHelper::unalignedShort(const_cast<char *>(value) + 1);
+  if (record != m_decompressedRecord || m_version != m_decompressedVersion) {
+    m_decompressedRecord = Record();
+    int outputSize = LZ4_decompress_safe(
+        value + k_compressedValueHeaderSize, m_decompressionBuffer,
+        size - k_compressedValueHeaderSize, k_decompressionBufferSize);
+    if (outputSize != static_cast<int>(decompressedSize)) {
+      return {.buffer = value, .size = 0};
+    }
+    s_decompressedBytes.add(decompressedSize);
+    m_decompressedRecord = record;
+    m_decompressedVersion = m_version;
+  }
+  return {.buffer = m_decompressionBuffer, .size = decompressedSize};
+}
+
+size_t FileSystem::writeValue(char *position, bool formatted,
+                              size_t compressedSize, const void *dataChunks[],
+                              size_t sizeChunks[], size_t numberOfChunks) {
+  if (compressedSize > 0) {
+    return overrideValueAtPosition(
+        position, m_decompressionBuffer + k_compressionStateSize,
+        compressedSize);
+  }
+  size_t size = 0;
+  if (formatted) {
+    position[0] = static_cast<char>(ValueFormat::Raw);
+    size += sizeof(ValueFormat);
+  }
+  for (size_t i = 0; i < numberOfChunks; i++) {
+    size += overrideValueAtPosition(position + size, dataChunks[i],
+                                    sizeChunks[i]);
+  }
+  return size;
+}
+
 bool FileSystem::isNameOfRecordTaken(Record r, const Record *recordToExclude) {
   if (r == Record()) {
     /* If the CRC32 of fullName is 0, we want to refuse the name as it would
@@ -503,16 +746,8 @@ bool FileSystem::isNameOfRecordTaken(Record r, const Record *recordToExclude) {
      * name is nullptr. */
     return true;
   }
-  for (char *p : *this) {
-    Record s(nameOfRecordStarting(p));
-    if (recordToExclude && s == *recordToExclude) {
-      continue;
-    }
-    if (s == r) {
-      return true;
-    }
-  }
-  return false;
+  return (!recordToExclude || r != *recordToExclude) &&
+         pointerOfRecord(r) != nullptr;
 }
 
 char *FileSystem::endBuffer() {
@@ -533,6 +768,7 @@ bool FileSystem::slideBuffer(char *position, int delta) {
   }
   memmove(position + delta, position,
           endBuffer() + sizeof(record_size_t) - position);
+  invalidateIndex();
   return true;
 }
 
@@ -547,18 +783,40 @@ Record FileSystem::privateRecordBasedNamedWithExtensions(
           numberOfExtensions, extensionResult)) {
     return m_lastRecordRetrieved;
   }
-  for (char *p : *this) {
-    Record::Name currentName = nameOfRecordStarting(p);
+  if (m_numberOfIndexedRecords < 0) {
+    buildIndex();
+  }
+  /* Records sharing the base name are all in the probe sequence of its hash.
+   * If several of them match, return the first one in the buffer, as a linear
+   * scan would. */
+  char *result = nullptr;
+  const char *resultExtension = nullptr;
+  for (int slot = FirstSlot(BaseNameHash(baseName, baseNameLength));
+       m_baseNameIndexOffsets[slot] != k_emptySlot; slot = NextSlot(slot)) {
+    char *p = m_buffer + m_baseNameIndexOffsets[slot];
+    const char *extension;
+    if ((!result || p < result) &&
+        recordNameHasBaseNameAndOneOfTheseExtensions(
+            nameOfRecordStarting(p), baseName, baseNameLength, extensions,
+            numberOfExtensions, &extension)) {
+      result = p;
+      resultExtension = extension;
+    }
+  }
+  // Unindexed records come after the indexed ones
+  for (RecordIterator it = beginUnindexedRecords(); !result && it != end();
+       ++it) {
+    s_scannedRecords.add();
     if (recordNameHasBaseNameAndOneOfTheseExtensions(
-            currentName, baseName, baseNameLength, extensions,
-            numberOfExtensions, extensionResult)) {
-      return Record(currentName);
+            nameOfRecordStarting(*it), baseName, baseNameLength, extensions,
+            numberOfExtensions, &resultExtension)) {
+      result = *it;
     }
   }
   if (extensionResult) {
-    *extensionResult = nullptr;
+    *extensionResult = result ? resultExtension : nullptr;
   }
-  return Record();
+  return result ? Record(nameOfRecordStarting(result)) : Record();
 }
 
 bool FileSystem::recordNameHasBaseNameAndOneOfTheseExtensions(
@@ -581,6 +839,48 @@ bool FileSystem::recordNameHasBaseNameAndOneOfTheseExtensions(
   return false;
 }
 
+void FileSystem::MemoizedFilter::set(const char *extension,
+                                     RecordFilter filter, char auxiliary) {
+  if (strlcpy(m_extension, extension, k_extensionSize) >= k_extensionSize) {
+    forget();
+    return;
+  }
+  m_filter = filter;
+  m_auxiliary = auxiliary;
+}
+
+FileSystem::RecordsWithExtension::Iterator::Iterator(char *recordStart,
+                                                     const char *extension)
+    : m_recordStart(recordStart), m_extension(extension) {
+  skipRecordsWithOtherExtensions();
+}
+
+Record FileSystem::RecordsWithExtension::Iterator::operator*() const {
+  assert(m_recordStart);
+  return Record(Record::CreateRecordNameFromFullName(m_recordStart +
+                                                     sizeof(record_size_t)));
+}
+
+FileSystem::RecordsWithExtension::Iterator &
+FileSystem::RecordsWithExtension::Iterator::operator++() {
+  m_recordStart = *++RecordIterator(m_recordStart);
+  skipRecordsWithOtherExtensions();
+  return *this;
+}
+
+void FileSystem::RecordsWithExtension::Iterator::
+    skipRecordsWithOtherExtensions() {
+  while (m_recordStart) {
+    Record::Name name = Record::CreateRecordNameFromFullName(
+        m_recordStart + sizeof(record_size_t));
+    if (!Record::NameIsEmpty(name) &&
+        strcmp(name.extension, m_extension) == 0) {
+      return;
+    }
+    m_recordStart = *++RecordIterator(m_recordStart);
+  }
+}
+
 FileSystem::RecordIterator &FileSystem::RecordIterator::operator++() {
   assert(m_recordStart);
   record_size_t size = StorageHelper::unalignedShort(m_recordStart);
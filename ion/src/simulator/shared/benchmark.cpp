@@ -0,0 +1,301 @@
+#include "benchmark.h"
+
+#include <assert.h>
+#include <ion/counters.h>
+#include <ion/events.h>
+#include <poincare/approximation_cache.h>
+#include <poincare/tree_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "journal/queue_journal.h"
+#include "state_file.h"
+
+namespace Ion {
+namespace Simulator {
+namespace Benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+static double millisecondsBetween(Clock::time_point start,
+                                  Clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+struct Scenario {
+  std::string name;
+  std::vector<Events::Event> events;
+  std::vector<double> wallTimes;
+  std::vector<double> eventLatencies;
+  size_t poolHighWaterMark = 0;
+  int approximationCacheHits = 0;
+  int approximationCacheMisses = 0;
+  std::vector<std::pair<std::string, uint32_t>> counters;
+#if POINCARE_TREE_STATS
+  Poincare::TreePool::Statistics poolStatistics = {};
+#endif
+};
+
+/* The benchmark is a replay journal: Events::getEvent asks it whether it is
+ * empty right before popping the next event, which is when the firmware is
+ * done processing the previous one. */
+
+class BenchmarkJournal : public Events::Journal {
+ public:
+  void pushEvent(Events::Event e) override { assert(false); }
+  Events::Event popEvent() override;
+  bool isEmpty() override;
+
+  std::vector<Scenario> m_scenarios;
+  int m_numberOfIterations = 1;
+
+ private:
+  void lap();
+
+  size_t m_scenarioIndex = 0;
+  int m_iteration = 0;
+  size_t m_eventIndex = 0;
+  bool m_eventPending = false;
+  Clock::time_point m_iterationStart;
+  Clock::time_point m_eventStart;
+};
+
+Events::Event BenchmarkJournal::popEvent() {
+  if (isEmpty()) {
+    return Events::None;
+  }
+  Scenario& scenario = m_scenarios[m_scenarioIndex];
+  if (m_eventIndex == 0 && m_iteration == 0) {
+    Poincare::ApproximationCache::SharedCache()->resetCounters();
+    Counters::Counter::ResetAll();
+#if POINCARE_TREE_STATS
+    Poincare::TreePool::sharedPool->resetStatistics();
+#endif
+  }
+  if (m_eventIndex == 0) {
+    Poincare::TreePool::sharedPool->resetHighWaterMark();
+    m_iterationStart = Clock::now();
+  }
+  m_eventPending = true;
+  m_eventStart = Clock::now();
+  return scenario.events[m_eventIndex++];
+}
+
+bool BenchmarkJournal::isEmpty() {
+  lap();
+  return m_scenarioIndex >= m_scenarios.size();
+}
+
+void BenchmarkJournal::lap() {
+  if (m_eventPending) {
+    Clock::time_point now = Clock::now();
+    Scenario& scenario = m_scenarios[m_scenarioIndex];
+    scenario.eventLatencies.push_back(millisecondsBetween(m_eventStart, now));
+    m_eventPending = false;
+    if (m_eventIndex < scenario.events.size()) {
+      return;
+    }
+    scenario.wallTimes.push_back(millisecondsBetween(m_iterationStart, now));
+    scenario.poolHighWaterMark =
+        std::max(scenario.poolHighWaterMark,
+                 Poincare::TreePool::sharedPool->highWaterMark());
+    m_eventIndex = 0;
+    if (++m_iteration < m_numberOfIterations) {
+      return;
+    }
+    m_iteration = 0;
+    Poincare::ApproximationCache* cache =
+        Poincare::ApproximationCache::SharedCache();
+    scenario.approximationCacheHits = cache->numberOfHits();
+    scenario.approximationCacheMisses = cache->numberOfMisses();
+    for (const Counters::Counter* c = Counters::Counter::First(); c != nullptr;
+         c = c->next()) {
+      scenario.counters.emplace_back(c->name(), c->value());
+    }
+#if POINCARE_TREE_STATS
+    scenario.poolStatistics = Poincare::TreePool::sharedPool->statistics();
+#endif
+    m_scenarioIndex++;
+  }
+  // Skip scenarios without events
+  while (m_scenarioIndex < m_scenarios.size() &&
+         m_scenarios[m_scenarioIndex].events.empty()) {
+    m_scenarioIndex++;
+  }
+}
+
+static BenchmarkJournal* sharedJournal() {
+  static BenchmarkJournal journal;
+  return &journal;
+}
+
+static std::string scenarioName(const char* path) {
+  std::string name(path);
+  size_t slash = name.find_last_of("/\\");
+  if (slash != std::string::npos) {
+    name.erase(0, slash + 1);
+  }
+  size_t dot = name.rfind('.');
+  if (dot != std::string::npos && dot > 0) {
+    name.erase(dot);
+  }
+  return name;
+}
+
+bool addScenario(const char* path) {
+  Journal::QueueJournal events;
+  if (!StateFile::loadInto(path, &events)) {
+    fprintf(stderr, "Error loading benchmark scenario %s\n", path);
+    return false;
+  }
+  BenchmarkJournal* journal = sharedJournal();
+  if (journal->m_scenarios.empty()) {
+    journal->setStartingLanguage(events.startingLanguage());
+  }
+  Scenario scenario;
+  scenario.name = scenarioName(path);
+  while (!events.isEmpty()) {
+    scenario.events.push_back(events.popEvent());
+  }
+  journal->m_scenarios.push_back(scenario);
+  return true;
+}
+
+void setNumberOfIterations(int iterations) {
+  sharedJournal()->m_numberOfIterations = std::max(iterations, 1);
+}
+
+bool hasScenarios() { return !sharedJournal()->m_scenarios.empty(); }
+
+const char* startingLanguage() { return sharedJournal()->startingLanguage(); }
+
+void start() { Events::replayFrom(sharedJournal()); }
+
+// Nearest-rank percentile of a sorted list
+static double percentile(const std::vector<double>& sortedValues, int rank) {
+  if (sortedValues.empty()) {
+    return 0.;
+  }
+  size_t index = (sortedValues.size() * rank + 99) / 100;
+  return sortedValues[std::max<size_t>(index, 1) - 1];
+}
+
+#if POINCARE_TREE_STATS
+static void reportPoolStatistics(
+    FILE* f, const Poincare::TreePool::Statistics& statistics) {
+  using Poincare::TreePool;
+  fprintf(f, "      \"tree_pool\": {\n");
+  fprintf(f, "        \"size_bytes\": %d,\n", TreePool::Size());
+  fprintf(f, "        \"allocations\": %d,\n", statistics.numberOfAllocations);
+  fprintf(f, "        \"allocated_bytes\": %zu,\n", statistics.allocatedBytes);
+  fprintf(f, "        \"moves\": %d,\n", statistics.numberOfMoves);
+  fprintf(f, "        \"moved_bytes\": %zu,\n", statistics.movedBytes);
+  fprintf(f, "        \"compacted_bytes\": %zu,\n", statistics.compactedBytes);
+  fprintf(f, "        \"pool_full_exceptions\": %d,\n",
+          statistics.numberOfPoolFullExceptions);
+  fprintf(f, "        \"peak_identifiers\": %d,\n",
+          statistics.peakNumberOfIdentifiers);
+  fprintf(f, "        \"identifiers\": %d,\n", TreePool::NumberOfIdentifiers());
+  // Node types, the most built first
+  std::vector<const TreePool::Statistics::NodeType*> types;
+  for (int i = 0; i < statistics.numberOfNodeTypes; i++) {
+    types.push_back(statistics.nodeTypes + i);
+  }
+  std::sort(types.begin(), types.end(),
+            [](const TreePool::Statistics::NodeType* a,
+               const TreePool::Statistics::NodeType* b) {
+              return a->numberOfBuilds > b->numberOfBuilds;
+            });
+  fprintf(f, "        \"untyped_builds\": %d,\n",
+          statistics.numberOfUntypedBuilds);
+  fprintf(f, "        \"builds\": [");
+  for (size_t i = 0; i < types.size(); i++) {
+    fprintf(f,
+            "%s\n          {\"type\": \"%s\", \"count\": %d, "
+            "\"bytes\": %zu}",
+            i == 0 ? "" : ",", types[i]->name, types[i]->numberOfBuilds,
+            types[i]->builtBytes);
+  }
+  fprintf(f, "\n        ]\n");
+  fprintf(f, "      }");
+}
+#endif
+
+static void reportScenario(FILE* f, const Scenario& scenario) {
+  std::vector<double> wallTimes = scenario.wallTimes;
+  std::vector<double> latencies = scenario.eventLatencies;
+  std::sort(wallTimes.begin(), wallTimes.end());
+  std::sort(latencies.begin(), latencies.end());
+  double totalWallTime = 0.;
+  for (double t : wallTimes) {
+    totalWallTime += t;
+  }
+  int runs = wallTimes.size();
+  fprintf(f, "    {\n");
+  fprintf(f, "      \"name\": \"%s\",\n", scenario.name.c_str());
+  fprintf(f, "      \"events\": %zu,\n", scenario.events.size());
+  fprintf(f, "      \"runs\": %d,\n", runs);
+  fprintf(f,
+          "      \"wall_time_ms\": {\"min\": %.3f, \"mean\": %.3f, "
+          "\"median\": %.3f, \"max\": %.3f},\n",
+          runs > 0 ? wallTimes.front() : 0.,
+          runs > 0 ? totalWallTime / runs : 0., percentile(wallTimes, 50),
+          runs > 0 ? wallTimes.back() : 0.);
+  fprintf(f,
+          "      \"event_latency_ms\": {\"p50\": %.3f, \"p90\": %.3f, "
+          "\"p99\": %.3f, \"max\": %.3f},\n",
+          percentile(latencies, 50), percentile(latencies, 90),
+          percentile(latencies, 99), percentile(latencies, 100));
+  fprintf(f, "      \"pool_high_water_mark_bytes\": %zu,\n",
+          scenario.poolHighWaterMark);
+  fprintf(f,
+          "      \"approximation_cache\": {\"hits\": %d, \"misses\": %d}",
+          scenario.approximationCacheHits, scenario.approximationCacheMisses);
+  // Counters are summed over the runs
+  fprintf(f, ",\n      \"counters\": {");
+  for (size_t i = 0; i < scenario.counters.size(); i++) {
+    fprintf(f, "%s\"%s\": %u", i == 0 ? "" : ", ",
+            scenario.counters[i].first.c_str(), scenario.counters[i].second);
+  }
+  fprintf(f, "}");
+#if POINCARE_TREE_STATS
+  fprintf(f, ",\n");
+  reportPoolStatistics(f, scenario.poolStatistics);
+#endif
+  fprintf(f, "\n    }");
+}
+
+bool report(const char* path) {
+  FILE* f = stdout;
+  if (path != nullptr) {
+    f = fopen(path, "w");
+    if (f == nullptr) {
+      fprintf(stderr, "Error opening benchmark output %s\n", path);
+      return false;
+    }
+  }
+  const BenchmarkJournal* journal = sharedJournal();
+  fprintf(f, "{\n");
+  fprintf(f, "  \"iterations\": %d,\n", journal->m_numberOfIterations);
+  fprintf(f, "  \"scenarios\": [\n");
+  for (size_t i = 0; i < journal->m_scenarios.size(); i++) {
+    reportScenario(f, journal->m_scenarios[i]);
+    fprintf(f, i + 1 < journal->m_scenarios.size() ? ",\n" : "\n");
+  }
+  fprintf(f, "  ]\n");
+  fprintf(f, "}\n");
+  if (f != stdout) {
+    fclose(f);
+  }
+  return true;
+}
+
+}  // namespace Benchmark
+}  // namespace Simulator
+}  // namespace Ion
@@ -0,0 +1,29 @@
+#ifndef ION_SIMULATOR_BENCHMARK_H
+#define ION_SIMULATOR_BENCHMARK_H
+
+namespace Ion {
+namespace Simulator {
+namespace Benchmark {
+
+/* The benchmark replays a list of state files, each one a given number of
+ * times, and measures how long the firmware takes to process their events.
+ * Run it headless:
+ * $ ./epsilon.bin --headless --benchmark a.nws --benchmark b.nws
+ *                 --benchmark-iterations 10 --benchmark-output out.json
+ * Scenarios are chained in the same process, so they should leave the
+ * firmware in the state they started from (typically by ending on Home). */
+
+bool addScenario(const char* path);
+void setNumberOfIterations(int iterations);
+bool hasScenarios();
+// Returns the language of the first scenario, or "" for the wildcard one
+const char* startingLanguage();
+void start();
+// Writes the results as JSON, on stdout if path is null
+bool report(const char* path);
+
+}  // namespace Benchmark
+}  // namespace Simulator
+}  // namespace Ion
+
+#endif
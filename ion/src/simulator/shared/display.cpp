@@ -30,8 +30,17 @@ void shutdown() {
 }
 
 void draw(SDL_Renderer* renderer, SDL_Rect* rect) {
-  SDL_UpdateTexture(sFramebufferTexture, nullptr, Framebuffer::address(),
-                    sizeof(KDColor) * Ion::Display::Width);
+  // The texture keeps the pixels that were not pushed since the last draw
+  for (int i = 0; i < Framebuffer::numberOfDamagedRects(); i++) {
+    KDRect damagedRect = Framebuffer::damagedRect(i);
+    SDL_Rect textureRect = {damagedRect.x(), damagedRect.y(),
+                            damagedRect.width(), damagedRect.height()};
+    SDL_UpdateTexture(sFramebufferTexture, &textureRect,
+                      Framebuffer::address() + damagedRect.x() +
+                          damagedRect.y() * Ion::Display::Width,
+                      sizeof(KDColor) * Ion::Display::Width);
+  }
+  Framebuffer::clearDamagedRects();
   SDL_RenderCopy(renderer, sFramebufferTexture, nullptr, rect);
 }
 
@@ -1,8 +1,10 @@
 #include "framebuffer.h"
 
+#include <assert.h>
 #include <ion/display.h>
 #include <kandinsky/color.h>
 #include <kandinsky/framebuffer.h>
+#include <limits.h>
 
 #include "window.h"
 
@@ -11,15 +13,46 @@
  * the GPU's memory. Reading data back from a texture is not possible, so we
  * simply maintain a framebuffer in RAM since Ion::Display::pullRect expects to
  * be able to read pixel data back.
- * A side effect is that we rewrite the whole texture when redrawing the screen.
- * This might not be the most efficient way since sending pixels to the GPU is
- * rather expensive.
  * This is also very useful when running headless because we can easily log the
- * framebuffer to a PNG file. */
+ * framebuffer to a PNG file.
+ * Since sending pixels to the GPU is rather expensive, only the rects pushed
+ * since the previous redraw are sent to the texture. */
 
 static KDColor sPixels[Ion::Display::Width * Ion::Display::Height];
 static bool sFrameBufferActive = false;
 
+/* Distant damaged rects are kept apart so that, for instance, a blinking
+ * cursor and the battery indicator don't cause the whole screen to be sent. */
+constexpr static int k_maxNumberOfDamagedRects = 4;
+static KDRect sDamagedRects[k_maxNumberOfDamagedRects] = {
+    KDRectZero, KDRectZero, KDRectZero, KDRectZero};
+static int sNumberOfDamagedRects = 0;
+
+static void addDamagedRect(KDRect rect) {
+  for (int i = 0; i < sNumberOfDamagedRects; i++) {
+    if (sDamagedRects[i].containsRect(rect)) {
+      return;
+    }
+  }
+  if (sNumberOfDamagedRects < k_maxNumberOfDamagedRects) {
+    sDamagedRects[sNumberOfDamagedRects++] = rect;
+    return;
+  }
+  // Merge rect with the damaged rect that grows the least
+  int bestIndex = 0;
+  int bestGrowth = INT_MAX;
+  for (int i = 0; i < sNumberOfDamagedRects; i++) {
+    KDRect merged = sDamagedRects[i].unionedWith(rect);
+    int growth = merged.width() * merged.height() -
+                 sDamagedRects[i].width() * sDamagedRects[i].height();
+    if (growth < bestGrowth) {
+      bestIndex = i;
+      bestGrowth = growth;
+    }
+  }
+  sDamagedRects[bestIndex] = sDamagedRects[bestIndex].unionedWith(rect);
+}
+
 namespace Ion {
 namespace Display {
 
@@ -29,6 +62,7 @@ static KDFrameBuffer sFrameBuffer =
 void pushRect(KDRect r, const KDColor* pixels) {
   if (sFrameBufferActive) {
     Simulator::Window::setNeedsRefresh();
+    addDamagedRect(r);
     sFrameBuffer.pushRect(r, pixels);
   }
 }
@@ -36,6 +70,7 @@ void pushRect(KDRect r, const KDColor* pixels) {
 void pushRectUniform(KDRect r, KDColor c) {
   if (sFrameBufferActive) {
     Simulator::Window::setNeedsRefresh();
+    addDamagedRect(r);
     sFrameBuffer.pushRectUniform(r, c);
   }
 }
@@ -55,7 +90,23 @@ namespace Framebuffer {
 
 const KDColor* address() { return sPixels; }
 
-void setActive(bool enabled) { sFrameBufferActive = enabled; }
+void setActive(bool enabled) {
+  if (enabled && !sFrameBufferActive) {
+    // The texture may not match the pixels anymore
+    sDamagedRects[0] = KDRect(0, 0, Display::Width, Display::Height);
+    sNumberOfDamagedRects = 1;
+  }
+  sFrameBufferActive = enabled;
+}
+
+int numberOfDamagedRects() { return sNumberOfDamagedRects; }
+
+KDRect damagedRect(int index) {
+  assert(index >= 0 && index < sNumberOfDamagedRects);
+  return sDamagedRects[index];
+}
+
+void clearDamagedRects() { sNumberOfDamagedRects = 0; }
 
 }  // namespace Framebuffer
 }  // namespace Simulator
@@ -2,6 +2,7 @@
 #define ION_SIMULATOR_FRAMEBUFFER_H
 
 #include <kandinsky/color.h>
+#include <kandinsky/rect.h>
 
 namespace Ion {
 namespace Simulator {
@@ -10,6 +11,11 @@ namespace Framebuffer {
 const KDColor* address();
 void setActive(bool enabled);
 
+// Rects covering all the pixels pushed since the damaged rects were cleared
+int numberOfDamagedRects();
+KDRect damagedRect(int index);
+void clearDamagedRects();
+
 }  // namespace Framebuffer
 }  // namespace Simulator
 }  // namespace Ion
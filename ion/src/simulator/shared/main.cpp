@@ -20,8 +20,10 @@
 #if ION_SIMULATOR_FILES
 #include <signal.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "actions.h"
+#include "benchmark.h"
 #include "screenshot.h"
 extern "C" {
 extern char *eadk_external_data;
@@ -34,6 +36,12 @@ constexpr static const char *k_loadStateFileKeys[] = {"--load-state-file",
                                                       "-l"};
 constexpr static const char *k_headlessFlags[] = {"--headless", "-h"};
 constexpr static const char *k_languageFlag = "--language";
+#if ION_SIMULATOR_FILES
+constexpr static const char *k_benchmarkKey = "--benchmark";
+constexpr static const char *k_benchmarkIterationsKey =
+    "--benchmark-iterations";
+constexpr static const char *k_benchmarkOutputKey = "--benchmark-output";
+#endif
 
 /* The Args class allows parsing and editing command-line arguments
  * The editing part allows us to add/remove arguments before forwarding them to
@@ -189,6 +197,29 @@ int main(int argc, char *argv[]) {
     args.push(k_languageFlag, replayJournalLanguage);
   }
 
+  const char *benchmarkOutput = args.pop(k_benchmarkOutputKey);
+  const char *benchmarkIterations = args.pop(k_benchmarkIterationsKey);
+  while (const char *benchmarkScenario = args.pop(k_benchmarkKey)) {
+    if (!Benchmark::addScenario(benchmarkScenario)) {
+      return -1;
+    }
+  }
+  bool benchmark = Benchmark::hasScenarios();
+  if (benchmark) {
+    if (stateFile) {
+      fprintf(stderr,
+              "Warning: the state file will be ignored while benchmarking.\n");
+    }
+    if (benchmarkIterations) {
+      Benchmark::setNumberOfIterations(atoi(benchmarkIterations));
+    }
+    const char *benchmarkLanguage = Benchmark::startingLanguage();
+    args.pop(k_languageFlag);
+    args.push(k_languageFlag,
+              benchmarkLanguage[0] == 0 ? "none" : benchmarkLanguage);
+    Benchmark::start();
+  }
+
   const char *screenshotPath = args.pop("--take-screenshot");
   if (screenshotPath) {
     Ion::Simulator::Screenshot::commandlineScreenshot()->init(screenshotPath);
@@ -250,6 +281,9 @@ int main(int argc, char *argv[]) {
     ion_main(args.argc(), args.argv());
 #if ION_SIMULATOR_FILES
   }
+  if (benchmark && !Benchmark::report(benchmarkOutput)) {
+    return -1;
+  }
 #endif
   if (!headless) {
     Haptics::shutdown();
@@ -30,7 +30,8 @@ constexpr static size_t sHeaderLength =
  * + EVENTS...
  */
 
-static inline bool loadFileHeader(const char* header) {
+static inline bool loadFileHeader(const char* header,
+                                  Ion::Events::Journal* journal) {
   const char* magic = header;
   const char* version = magic + sMagicLength;
   const char* formatVersion = version + sVersionLength;
@@ -47,12 +48,12 @@ static inline bool loadFileHeader(const char* header) {
     return false;
   }
   if (strncmp(language, sWildcardLanguage, sLanguageLength) != 0) {
-    Journal::replayJournal()->setStartingLanguage(language);
+    journal->setStartingLanguage(language);
   }
   return true;
 }
 
-static inline void pushEvent(uint8_t c) {
+static inline void pushEvent(uint8_t c, Ion::Events::Journal* journal) {
   Ion::Events::Event e = Ion::Events::Event(c);
   if (!Events::isDefined(static_cast<uint8_t>(
           e))) {  // If not defined, fall back on a normal key event.
@@ -66,32 +67,31 @@ static inline void pushEvent(uint8_t c) {
     return;
   }
   /* ExternalText is not yet handled by state files. */
-  Journal::replayJournal()->pushEvent(e);
+  journal->pushEvent(e);
 }
 
-static inline bool loadFile(FILE* f, bool headlessStateFile) {
+static inline bool loadFile(FILE* f, Ion::Events::Journal* journal,
+                            bool headlessStateFile) {
   if (!headlessStateFile) {
     char header[sHeaderLength + 1];
     header[sHeaderLength] = 0;
     if (fread(header, sHeaderLength, 1, f) != 1) {
       return false;
     }
-    if (!loadFileHeader(header)) {
+    if (!loadFileHeader(header, journal)) {
       return false;
     }
   }
   // Events
   int c = 0;
   while ((c = getc(f)) != EOF) {
-    pushEvent(c);
+    pushEvent(c, journal);
   }
-
-  Ion::Events::replayFrom(Journal::replayJournal());
-
   return true;
 }
 
-void load(const char* filename, bool headlessStateFile) {
+bool loadInto(const char* filename, Ion::Events::Journal* journal,
+              bool headlessStateFile) {
   FILE* f = nullptr;
   if (strcmp(filename, "-") == 0) {
     f = stdin;
@@ -99,12 +99,19 @@ void load(const char* filename, bool headlessStateFile) {
     f = fopen(filename, "rb");
   }
   if (f == nullptr) {
-    return;
+    return false;
   }
-  loadFile(f, headlessStateFile);
+  bool result = loadFile(f, journal, headlessStateFile);
   if (f != stdin) {
     fclose(f);
   }
+  return result;
+}
+
+void load(const char* filename, bool headlessStateFile) {
+  if (loadInto(filename, Journal::replayJournal(), headlessStateFile)) {
+    Ion::Events::replayFrom(Journal::replayJournal());
+  }
 }
 
 void loadMemory(const char* buffer, size_t length, bool headlessStateFile) {
@@ -115,14 +122,14 @@ void loadMemory(const char* buffer, size_t length, bool headlessStateFile) {
     if (length < sHeaderLength) {
       return;
     }
-    if (!loadFileHeader(buffer)) {
+    if (!loadFileHeader(buffer, Journal::replayJournal())) {
       return;
     }
     e = reinterpret_cast<const uint8_t*>(buffer + sHeaderLength);
   }
   const uint8_t* bufferEnd = reinterpret_cast<const uint8_t*>(buffer + length);
   while (e != bufferEnd) {
-    pushEvent(*e++);
+    pushEvent(*e++, Journal::replayJournal());
   }
   Ion::Events::replayFrom(Journal::replayJournal());
 }
@@ -1,11 +1,17 @@
 #ifndef ION_SIMULATOR_STATE_FILE_H
 #define ION_SIMULATOR_STATE_FILE_H
 
+#include <ion/events.h>
+
 namespace Ion {
 namespace Simulator {
 namespace StateFile {
 
 void load(const char* filename, bool headlessStateFile = false);
+/* Read the events of a state file into journal without starting the replay.
+ * Returns false if the file cannot be read or has an invalid header. */
+bool loadInto(const char* filename, Ion::Events::Journal* journal,
+              bool headlessStateFile = false);
 bool loadMemory(const char* buffer, size_t length,
                 bool headlessStateFiles = false);
 void save(const char* filename);
@@ -189,6 +189,358 @@ QUIZ_CASE(ion_storage_valid_renaming) {
               initialStorageAvailableStage);
 }
 
+QUIZ_CASE(ion_storage_many_records) {
+  /* Create more records than the FileSystem index can hold, so that lookups go
+   * through both the index and the linear scan of the following records. */
+  constexpr int k_numberOfRecords = 150;
+  constexpr const char *k_extensions[] = {"record1", "record2"};
+  size_t initialStorageAvailableStage =
+      Storage::FileSystem::sharedFileSystem->availableSize();
+  char baseName[] = "r000";
+  auto setBaseName = [&baseName](int i) {
+    baseName[1] = '0' + i / 100;
+    baseName[2] = '0' + (i / 10) % 10;
+    baseName[3] = '0' + i % 10;
+  };
+  for (int i = 0; i < k_numberOfRecords; i++) {
+    setBaseName(i);
+    quiz_assert(putRecordInSharedStorage(baseName, k_extensions[i % 2],
+                                         baseName) ==
+                Storage::Record::ErrorStatus::None);
+  }
+
+  // Look every record up, with each of the lookup methods
+  for (int i = 0; i < k_numberOfRecords; i++) {
+    setBaseName(i);
+    Storage::Record r =
+        Storage::FileSystem::sharedFileSystem->recordBaseNamedWithExtension(
+            baseName, k_extensions[i % 2]);
+    quiz_assert(!r.isNull());
+    quiz_assert(strncmp(static_cast<const char *>(r.value().buffer), baseName,
+                        strlen(baseName)) == 0);
+    quiz_assert(Storage::FileSystem::sharedFileSystem
+                    ->recordBaseNamedWithExtension(baseName,
+                                                   k_extensions[1 - i % 2])
+                    .isNull());
+    quiz_assert(
+        Storage::FileSystem::sharedFileSystem->recordBaseNamedWithExtensions(
+            baseName, k_extensions, 2) == r);
+    quiz_assert(Storage::FileSystem::sharedFileSystem
+                    ->extensionOfRecordBaseNamedWithExtensions(
+                        baseName, strlen(baseName), k_extensions, 2) ==
+                k_extensions[i % 2]);
+  }
+
+  // Destroy every third record and rename the others
+  for (int i = 0; i < k_numberOfRecords; i++) {
+    setBaseName(i);
+    Storage::Record r =
+        Storage::FileSystem::sharedFileSystem->recordBaseNamedWithExtension(
+            baseName, k_extensions[i % 2]);
+    if (i % 3 == 0) {
+      r.destroy();
+    } else {
+      quiz_assert(Storage::Record::SetBaseNameWithExtension(
+                      &r, baseName, k_extensions[1 - i % 2]) ==
+                  Storage::Record::ErrorStatus::None);
+    }
+  }
+  for (int i = 0; i < k_numberOfRecords; i++) {
+    setBaseName(i);
+    Storage::Record r =
+        Storage::FileSystem::sharedFileSystem->recordBaseNamedWithExtensions(
+            baseName, k_extensions, 2);
+    if (i % 3 == 0) {
+      quiz_assert(r.isNull());
+    } else {
+      quiz_assert(!r.isNull() &&
+                  r == Storage::FileSystem::sharedFileSystem
+                           ->recordBaseNamedWithExtension(
+                               baseName, k_extensions[1 - i % 2]));
+    }
+  }
+
+  Storage::FileSystem::sharedFileSystem->destroyRecordsWithExtension(
+      k_extensions[0]);
+  Storage::FileSystem::sharedFileSystem->destroyRecordsWithExtension(
+      k_extensions[1]);
+  quiz_assert(Storage::FileSystem::sharedFileSystem->availableSize() ==
+              initialStorageAvailableStage);
+}
+
+QUIZ_CASE(ion_storage_records_with_extension) {
+  const char *extension = "record1";
+  const char *otherExtension = "record2";
+  size_t initialStorageAvailableStage =
+      Storage::FileSystem::sharedFileSystem->availableSize();
+  char baseName[] = "r0";
+  for (int i = 0; i < 10; i++) {
+    baseName[1] = '0' + i;
+    quiz_assert(putRecordInSharedStorage(
+                    baseName, i % 3 == 0 ? otherExtension : extension,
+                    baseName) == Storage::Record::ErrorStatus::None);
+  }
+  // r1, r2, r4, r5, r7 and r8 have the extension
+  const char *expectedBaseNames = "124578";
+  int numberOfRecords = strlen(expectedBaseNames);
+
+  for (int step = 0; step < 2; step++) {
+    // Enumerate in a single pass
+    int i = 0;
+    for (Storage::Record r :
+         Storage::FileSystem::sharedFileSystem->recordsWithExtension(
+             extension)) {
+      quiz_assert(i < numberOfRecords);
+      Storage::Record::Name name = r.name();
+      quiz_assert(name.baseNameLength == 2 &&
+                  name.baseName[1] == expectedBaseNames[i]);
+      i++;
+    }
+    quiz_assert(i == numberOfRecords);
+
+    // Iterate by index, forwards then backwards
+    quiz_assert(Storage::FileSystem::sharedFileSystem
+                    ->numberOfRecordsWithExtension(extension) ==
+                numberOfRecords);
+    for (int j = 0; j < 2 * numberOfRecords; j++) {
+      int index = j < numberOfRecords ? j : 2 * numberOfRecords - 1 - j;
+      Storage::Record r =
+          Storage::FileSystem::sharedFileSystem->recordWithExtensionAtIndex(
+              extension, index);
+      quiz_assert(r.name().baseName[1] == expectedBaseNames[index]);
+    }
+    quiz_assert(
+        Storage::FileSystem::sharedFileSystem
+            ->recordWithExtensionAtIndex(extension, numberOfRecords)
+            .isNull());
+    quiz_assert(Storage::FileSystem::sharedFileSystem
+                    ->recordWithExtensionAtIndexStartingWithout(
+                        'r', extension, 0)
+                    .isNull());
+
+    // Memoized positions and counts are forgotten when records change
+    Storage::FileSystem::sharedFileSystem
+        ->recordBaseNamedWithExtension("r3", otherExtension)
+        .destroy();
+    Storage::FileSystem::sharedFileSystem
+        ->recordBaseNamedWithExtension("r0", otherExtension)
+        .destroy();
+    Storage::Record r =
+        Storage::FileSystem::sharedFileSystem->recordBaseNamedWithExtension(
+            "r4", extension);
+    quiz_assert(r.setValue({.buffer = "r4r4r4r4", .size = 9}) ==
+                Storage::Record::ErrorStatus::None);
+  }
+
+  Storage::FileSystem::sharedFileSystem->destroyRecordsWithExtension(
+      extension);
+  Storage::FileSystem::sharedFileSystem->destroyRecordsWithExtension(
+      otherExtension);
+  quiz_assert(Storage::FileSystem::sharedFileSystem->availableSize() ==
+              initialStorageAvailableStage);
+}
+
+QUIZ_CASE(ion_storage_invalidate_memoization) {
+  const char *extension = "record1";
+  size_t initialStorageAvailableStage =
+      Storage::FileSystem::sharedFileSystem->availableSize();
+  quiz_assert(putRecordInSharedStorage("r0", extension, "r0") ==
+              Storage::Record::ErrorStatus::None);
+  quiz_assert(putRecordInSharedStorage("r1", extension, "r1") ==
+              Storage::Record::ErrorStatus::None);
+  // Fill the index, the cursor and the count
+  Storage::Record r1 =
+      Storage::FileSystem::sharedFileSystem->recordBaseNamedWithExtension(
+          "r1", extension);
+  quiz_assert(
+      Storage::FileSystem::sharedFileSystem->recordWithExtensionAtIndex(
+          extension, 1) == r1);
+  quiz_assert(Storage::FileSystem::sharedFileSystem
+                  ->numberOfRecordsWithExtension(extension) == 2);
+
+  uint32_t version = Storage::FileSystem::sharedFileSystem->version();
+  Storage::FileSystem::sharedFileSystem->invalidateMemoization();
+  quiz_assert(Storage::FileSystem::sharedFileSystem->version() != version);
+  quiz_assert(
+      Storage::FileSystem::sharedFileSystem->recordBaseNamedWithExtension(
+          "r1", extension) == r1);
+  quiz_assert(
+      Storage::FileSystem::sharedFileSystem->recordWithExtensionAtIndex(
+          extension, 1) == r1);
+  quiz_assert(Storage::FileSystem::sharedFileSystem
+                  ->numberOfRecordsWithExtension(extension) == 2);
+
+  Storage::FileSystem::sharedFileSystem->destroyRecordsWithExtension(
+      extension);
+  quiz_assert(Storage::FileSystem::sharedFileSystem->availableSize() ==
+              initialStorageAvailableStage);
+}
+
+static bool recordHasValue(Storage::Record r, const char *data, size_t size) {
+  Storage::Record::Data value = r.value();
+  return value.size == size && memcmp(value.buffer, data, size) == 0;
+}
+
+QUIZ_CASE(ion_storage_compressed_values) {
+  size_t initialStorageAvailableStage =
+      Storage::FileSystem::sharedFileSystem->availableSize();
+  char repetitive[1000];
+  char otherRepetitive[600];
+  char random[300];
+  char large[6000];
+  uint32_t seed = 1;
+  for (size_t i = 0; i < sizeof(large); i++) {
+    seed = seed * 1103515245 + 12345;
+    if (i < sizeof(repetitive)) {
+      repetitive[i] = "0123456789"[i % 10];
+    }
+    if (i < sizeof(otherRepetitive)) {
+      otherRepetitive[i] = "abc"[i % 3];
+    }
+    if (i < sizeof(random)) {
+      random[i] = seed >> 24;
+    }
+    large[i] = "xyz"[i % 3];
+  }
+
+  // Repetitive values of variables are compressed
+  quiz_assert(Storage::FileSystem::sharedFileSystem->createRecordWithExtension(
+                  "L1", Storage::lisExtension, repetitive,
+                  sizeof(repetitive)) == Storage::Record::ErrorStatus::None);
+  Storage::Record l1("L1", Storage::lisExtension);
+  quiz_assert(initialStorageAvailableStage -
+                  Storage::FileSystem::sharedFileSystem->availableSize() <
+              sizeof(repetitive) / 2);
+  quiz_assert(recordHasValue(l1, repetitive, sizeof(repetitive)));
+
+  // Other values are stored raw
+  size_t availableSize = Storage::FileSystem::sharedFileSystem->availableSize();
+  quiz_assert(Storage::FileSystem::sharedFileSystem->createRecordWithExtension(
+                  "L2", Storage::lisExtension, random, sizeof(random)) ==
+              Storage::Record::ErrorStatus::None);
+  quiz_assert(Storage::FileSystem::sharedFileSystem->createRecordWithExtension(
+                  "script", "py", repetitive, sizeof(repetitive)) ==
+              Storage::Record::ErrorStatus::None);
+  quiz_assert(Storage::FileSystem::sharedFileSystem->createRecordWithExtension(
+                  "L3", Storage::lisExtension, large, sizeof(large)) ==
+              Storage::Record::ErrorStatus::None);
+  quiz_assert(availableSize -
+                  Storage::FileSystem::sharedFileSystem->availableSize() >
+              sizeof(random) + sizeof(repetitive) + sizeof(large));
+  Storage::Record l2("L2", Storage::lisExtension);
+  Storage::Record script("script", "py");
+  Storage::Record l3("L3", Storage::lisExtension);
+  quiz_assert(recordHasValue(l2, random, sizeof(random)));
+  quiz_assert(recordHasValue(script, repetitive, sizeof(repetitive)));
+  quiz_assert(recordHasValue(l3, large, sizeof(large)));
+
+  // Compressed values can be read one after the other
+  quiz_assert(Storage::FileSystem::sharedFileSystem->createRecordWithExtension(
+                  "M", Storage::matExtension, otherRepetitive,
+                  sizeof(otherRepetitive)) ==
+              Storage::Record::ErrorStatus::None);
+  Storage::Record m("M", Storage::matExtension);
+  for (int i = 0; i < 2; i++) {
+    quiz_assert(recordHasValue(m, otherRepetitive, sizeof(otherRepetitive)));
+    quiz_assert(recordHasValue(l1, repetitive, sizeof(repetitive)));
+  }
+
+  // Values are compressed again when they change
+  quiz_assert(l1.setValue({.buffer = random, .size = sizeof(random)}) ==
+              Storage::Record::ErrorStatus::None);
+  quiz_assert(recordHasValue(l1, random, sizeof(random)));
+  quiz_assert(l1.setValue({.buffer = otherRepetitive,
+                           .size = sizeof(otherRepetitive)}) ==
+              Storage::Record::ErrorStatus::None);
+  quiz_assert(recordHasValue(l1, otherRepetitive, sizeof(otherRepetitive)));
+  quiz_assert(l1.setValue(m.value()) == Storage::Record::ErrorStatus::None);
+  quiz_assert(recordHasValue(l1, otherRepetitive, sizeof(otherRepetitive)));
+  quiz_assert(recordHasValue(m, otherRepetitive, sizeof(otherRepetitive)));
+
+  l1.destroy();
+  l2.destroy();
+  l3.destroy();
+  m.destroy();
+  script.destroy();
+  quiz_assert(Storage::FileSystem::sharedFileSystem->availableSize() ==
+              initialStorageAvailableStage);
+}
+
+QUIZ_CASE(ion_storage_invalid_compressed_values) {
+  size_t initialStorageAvailableStage =
+      Storage::FileSystem::sharedFileSystem->availableSize();
+  /* Values written without a format byte, or with a corrupted LZ4 block, are
+   * read as empty values. Renaming a raw record bypasses the encoding. */
+  char unknownFormat[200];
+  char corruptedBlock[200];
+  for (size_t i = 0; i < sizeof(corruptedBlock); i++) {
+    unknownFormat[i] = 7;
+    corruptedBlock[i] = 0xFF;
+  }
+  // LZ4 format byte, followed by a decompressed size of 1000 bytes
+  corruptedBlock[0] = 1;
+  corruptedBlock[1] = static_cast<char>(1000 & 0xFF);
+  corruptedBlock[2] = static_cast<char>(1000 >> 8);
+  const char *data[] = {unknownFormat, corruptedBlock};
+  for (const char *value : data) {
+    quiz_assert(
+        Storage::FileSystem::sharedFileSystem->createRecordWithExtension(
+            "L1", "raw", value, 200) == Storage::Record::ErrorStatus::None);
+    Storage::Record r("L1", "raw");
+    quiz_assert(Storage::Record::SetBaseNameWithExtension(
+                    &r, "L1", Storage::lisExtension) ==
+                Storage::Record::ErrorStatus::None);
+    quiz_assert(r.value().size == 0);
+    r.destroy();
+  }
+  quiz_assert(Storage::FileSystem::sharedFileSystem->availableSize() ==
+              initialStorageAvailableStage);
+}
+
+QUIZ_CASE(ion_storage_upgrade_value_format) {
+  size_t initialStorageAvailableStage =
+      Storage::FileSystem::sharedFileSystem->availableSize();
+  /* Write a value without format byte, as it was before values had one, and
+   * mark the storage with the previous magic, as the host would. */
+  char rawValue[200];
+  for (size_t i = 0; i < sizeof(rawValue); i++) {
+    rawValue[i] = i;
+  }
+  quiz_assert(Storage::FileSystem::sharedFileSystem->createRecordWithExtension(
+                  "L1", "raw", rawValue, sizeof(rawValue)) ==
+              Storage::Record::ErrorStatus::None);
+  quiz_assert(putRecordInSharedStorage("script", "py", "print(1)") ==
+              Storage::Record::ErrorStatus::None);
+  Storage::Record l1("L1", "raw");
+  quiz_assert(Storage::Record::SetBaseNameWithExtension(
+                  &l1, "L1", Storage::lisExtension) ==
+              Storage::Record::ErrorStatus::None);
+  uint32_t *magicHeader = reinterpret_cast<uint32_t *>(
+      static_cast<void *>(Storage::FileSystem::sharedFileSystem));
+  uint32_t *magicFooter = reinterpret_cast<uint32_t *>(
+      reinterpret_cast<char *>(magicHeader) + sizeof(uint32_t) +
+      Storage::FileSystem::k_storageSize);
+  uint32_t magic = *magicHeader;
+  *magicHeader = 0xEE0BDDBA;
+  *magicFooter = 0xEE0BDDBA;
+
+  Storage::FileSystem::sharedFileSystem->invalidateMemoization();
+  Storage::FileSystem::sharedFileSystem->upgradeValueFormat();
+  quiz_assert(*magicHeader == magic && *magicFooter == magic);
+  quiz_assert(recordHasValue(l1, rawValue, sizeof(rawValue)));
+  Storage::Record script("script", "py");
+  quiz_assert(recordHasValue(script, "print(1)", 8));
+
+  // Values are upgraded only once
+  Storage::FileSystem::sharedFileSystem->upgradeValueFormat();
+  quiz_assert(recordHasValue(l1, rawValue, sizeof(rawValue)));
+
+  l1.destroy();
+  script.destroy();
+  quiz_assert(Storage::FileSystem::sharedFileSystem->availableSize() ==
+              initialStorageAvailableStage);
+}
+
 QUIZ_CASE(ion_storage_available_space_moving) {
   const char *extensionRecord = "record1";
   const char *baseNameRecord1 = "ionTestStorage1";
@@ -31,6 +31,13 @@ class KDColor {
   }
 
   static KDColor Blend(KDColor first, KDColor second, uint8_t alpha);
+  /* Row kernels of the rect fills, vectorized when the target has SIMD
+   * instructions:
+   * - pixels[i] = Blend(pixels[i], color, alphas[i])
+   * - pixels[i] = color */
+  static void BlendRow(KDColor* pixels, KDColor color, const uint8_t* alphas,
+                       int numberOfPixels);
+  static void FillRow(KDColor* pixels, KDColor color, int numberOfPixels);
   operator uint16_t() const { return m_value; }
 
   struct HSVColor {
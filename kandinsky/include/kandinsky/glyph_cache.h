@@ -0,0 +1,55 @@
+#ifndef KANDINSKY_GLYPH_CACHE_H
+#define KANDINSKY_GLYPH_CACHE_H
+
+#include <kandinsky/glyph.h>
+
+/* Number of colorized glyphs kept by the cache. Each glyph takes about
+ * KDFont::k_maxGlyphPixelCount * sizeof(KDColor) = 360B of RAM, which the
+ * device cannot spare: the cache is disabled there. */
+#ifndef KANDINSKY_NUMBER_OF_CACHED_GLYPHS
+#if PLATFORM_DEVICE
+#define KANDINSKY_NUMBER_OF_CACHED_GLYPHS 0
+#else
+#define KANDINSKY_NUMBER_OF_CACHED_GLYPHS 32
+#endif
+#endif
+
+/* The KDGlyphCache keeps the last glyphs drawn by KDContext::drawString,
+ * decompressed and colorized, so that redrawing the same texts skips both
+ * steps. Glyphs are identified by their code point and style, and the least
+ * recently used one is recycled on a miss. Glyphs superimposed with combining
+ * code points are not cached. */
+
+class KDGlyphCache {
+ public:
+  constexpr static int k_numberOfGlyphs = KANDINSKY_NUMBER_OF_CACHED_GLYPHS;
+
+  /* Returns the colorized pixels of the glyph. They remain valid until
+   * k_numberOfGlyphs other glyphs are requested. palette must be the render
+   * palette of style. workingBuffer is trashed on a miss. Must not be called
+   * when the cache is disabled. */
+  static const KDColor* Glyph(CodePoint codePoint, KDGlyph::Style style,
+                              const KDFont::RenderPalette* palette,
+                              KDFont::GlyphBuffer* workingBuffer);
+  static void Clear();
+
+#if KANDINSKY_NUMBER_OF_CACHED_GLYPHS > 0
+ private:
+  struct CachedGlyph {
+    // Glyphs are never requested for UCodePointNull, which marks free slots
+    uint32_t codePoint;
+    KDColor glyphColor;
+    KDColor backgroundColor;
+    KDFont::Size font;
+    // Value of s_numberOfRequests when the glyph was last requested
+    uint32_t lastUse;
+    // Only the colorized pixels are kept, not the grayscale working buffers
+    KDColor pixels[KDFont::k_maxGlyphPixelCount];
+  };
+
+  static CachedGlyph s_glyphs[k_numberOfGlyphs];
+  static uint32_t s_numberOfRequests;
+#endif
+};
+
+#endif
@@ -12,11 +12,34 @@ class KDIonContext : public KDContext {
   static void Putchar(char c);
   static void Clear(KDPoint newCursorPosition = KDPointZero);
 
+  /* While recording, uniform fills are kept in a short display list instead of
+   * being pushed right away. A fill that is then covered by another push is
+   * dropped, and a fill adjacent to the previous one of the same color is
+   * merged with it. The display list is flushed when the recording stops, or
+   * earlier when the recorded fills must reach the display before another
+   * push or pull. */
+  void startRecording() { m_recording = true; }
+  void stopRecording();
+  bool isRecording() const { return m_recording; }
+
  private:
+  constexpr static int k_maxNumberOfRecordedFills = 8;
+  struct UniformFill {
+    KDRect rect = KDRectZero;
+    KDColor color;
+  };
+
   KDIonContext();
   void pushRect(KDRect rect, const KDColor* pixels) override;
   void pushRectUniform(KDRect rect, KDColor color) override;
   void pullRect(KDRect rect, KDColor* pixels) override;
+  void dropRecordedFillsCoveredBy(KDRect rect);
+  bool recordedFillsIntersect(KDRect rect) const;
+  void flushRecordedFills(int numberOfFills);
+
+  UniformFill m_recordedFills[k_maxNumberOfRecordedFills];
+  int m_numberOfRecordedFills;
+  bool m_recording;
 };
 
 #endif
@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <kandinsky/context.h>
+#include <string.h>
 
 KDRect KDContext::relativeRect(KDRect rect) {
   return rect.intersectedWith(m_clippingRect).relativeTo(m_origin);
@@ -61,10 +62,10 @@ void KDContext::fillRectWithPixels(KDRect rect, const KDColor *pixels,
     }
   } else {
     for (KDCoordinate j = 0; j < absoluteRect.height(); j++) {
-      for (KDCoordinate i = 0; i < absoluteRect.width(); i++) {
-        workingBuffer[i + absoluteRect.width() * j] =
-            pixels[startingI + i + rect.width() * (startingJ + j)];
-      }
+      // workingBuffer may be pixels, rows can overlap
+      memmove(workingBuffer + absoluteRect.width() * j,
+              pixels + startingI + rect.width() * (startingJ + j),
+              absoluteRect.width() * sizeof(KDColor));
     }
     pushRect(absoluteRect, workingBuffer);
   }
@@ -84,14 +85,10 @@ void KDContext::fillRectWithMask(KDRect rect, KDColor color, KDColor background,
   startingI = std::max<KDCoordinate>(0, startingI);
   startingJ = std::max<KDCoordinate>(0, startingJ);
   for (KDCoordinate j = 0; j < absoluteRect.height(); j++) {
-    for (KDCoordinate i = 0; i < absoluteRect.width(); i++) {
-      KDColor *currentPixelAddress =
-          workingBuffer + i + absoluteRect.width() * j;
-      const uint8_t *currentMaskAddress =
-          mask + i + startingI + rect.width() * (j + startingJ);
-      *currentPixelAddress =
-          KDColor::Blend(background, color, *currentMaskAddress);
-    }
+    KDColor *row = workingBuffer + absoluteRect.width() * j;
+    const uint8_t *maskRow = mask + startingI + rect.width() * (j + startingJ);
+    KDColor::FillRow(row, background, absoluteRect.width());
+    KDColor::BlendRow(row, color, maskRow, absoluteRect.width());
   }
   pushRect(absoluteRect, workingBuffer);
 }
@@ -113,16 +110,9 @@ void KDContext::blendRectWithMask(KDRect rect, KDColor color,
   startingI = std::max<KDCoordinate>(0, startingI);
   startingJ = std::max<KDCoordinate>(0, startingJ);
   for (KDCoordinate j = 0; j < absoluteRect.height(); j++) {
-    for (KDCoordinate i = 0; i < absoluteRect.width(); i++) {
-      KDColor *currentPixelAddress =
-          workingBuffer + i + absoluteRect.width() * j;
-      const uint8_t *currentMaskAddress =
-          mask + i + startingI + rect.width() * (j + startingJ);
-      *currentPixelAddress =
-          KDColor::Blend(*currentPixelAddress, color, *currentMaskAddress);
-      /* *currentPixelAddress = KDColorBlend(*currentPixelAddress, color,
-       * *currentMaskAddress); */
-    }
+    KDColor::BlendRow(workingBuffer + absoluteRect.width() * j, color,
+                      mask + startingI + rect.width() * (j + startingJ),
+                      absoluteRect.width());
   }
   pushRect(absoluteRect, workingBuffer);
 }
@@ -3,6 +3,7 @@
 #include <ion/unicode/utf8_decoder.h>
 #include <kandinsky/context.h>
 #include <kandinsky/font.h>
+#include <kandinsky/glyph_cache.h>
 
 #include <cmath>
 
@@ -93,20 +94,29 @@ KDPoint KDContext::drawString(const char* text, KDPoint p, KDGlyph::Style style,
       codePoint = decoder.nextCodePoint();
     } else {
       assert(!codePoint.isCombining());
-      KDFont::Font(style.font)
-          ->setGlyphGrayscalesForCodePoint(codePoint, &glyphBuffer);
+      CodePoint baseCodePoint = codePoint;
       codePoint = decoder.nextCodePoint();
-      while (codePoint.isCombining()) {
+      const KDColor* glyphPixels;
+      if (KDGlyphCache::k_numberOfGlyphs == 0 || codePoint.isCombining()) {
         KDFont::Font(style.font)
-            ->accumulateGlyphGrayscalesForCodePoint(codePoint, &glyphBuffer);
-        codePointPointer = decoder.stringPosition();
-        codePoint = decoder.nextCodePoint();
+            ->setGlyphGrayscalesForCodePoint(baseCodePoint, &glyphBuffer);
+        while (codePoint.isCombining()) {
+          KDFont::Font(style.font)
+              ->accumulateGlyphGrayscalesForCodePoint(codePoint, &glyphBuffer);
+          codePointPointer = decoder.stringPosition();
+          codePoint = decoder.nextCodePoint();
+        }
+        KDFont::Font(style.font)->colorizeGlyphBuffer(&palette, &glyphBuffer);
+        glyphPixels = glyphBuffer.colorBuffer();
+      } else {
+        glyphPixels =
+            KDGlyphCache::Glyph(baseCodePoint, style, &palette, &glyphBuffer);
       }
-      KDFont::Font(style.font)->colorizeGlyphBuffer(&palette, &glyphBuffer);
       /* Push the character on the screen
        * It's OK to trash the content of the color buffer since we'll re-fetch
-       * it for the next char anyway */
-      fillRectWithPixels(KDRect(position, glyphSize), glyphBuffer.colorBuffer(),
+       * it for the next char anyway. Cached glyphs must not be trashed, so
+       * they are never used as the working buffer. */
+      fillRectWithPixels(KDRect(position, glyphSize), glyphPixels,
                          glyphBuffer.colorBuffer());
       position = position.translatedBy(KDPoint(glyphSize.width(), 0));
       if (origin().x() + position.x() >= Ion::Display::Width) {
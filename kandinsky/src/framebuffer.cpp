@@ -11,6 +11,12 @@ KDColor* KDFrameBuffer::pixelAddress(KDPoint p) const {
 }
 
 void KDFrameBuffer::pushRect(KDRect rect, const KDColor* pixels) {
+  if (rect.width() == m_size.width()) {
+    // The rows are contiguous
+    memcpy(pixelAddress(rect.origin()), pixels,
+           rect.width() * rect.height() * sizeof(KDColor));
+    return;
+  }
   const KDColor* line = pixels;
   for (KDCoordinate j = 0; j < rect.height(); j++) {
     KDPoint lineOffset = KDPoint(0, j);
@@ -22,17 +28,16 @@ void KDFrameBuffer::pushRect(KDRect rect, const KDColor* pixels) {
 
 void KDFrameBuffer::pushRectUniform(KDRect rect, KDColor color) {
   // Caution: this code is used very frequently. It's worth optimizing!
+  if (rect.width() == m_size.width()) {
+    // The rows are contiguous
+    KDColor::FillRow(pixelAddress(rect.origin()), color,
+                     rect.width() * rect.height());
+    return;
+  }
   KDColor* pixel = pixelAddress(rect.origin());
-  int lineDelta = m_size.width() - rect.width();
   for (KDCoordinate j = 0; j < rect.height(); j++) {
-    /* KDColor * topLeftPixelAddress =
-     * pixelAddress(rect.origin().translatedBy(KDPoint(0,j)));
-     * *pixelAddress(rect.origin().translatedBy(KDPoint(i,j))) = color; */
-    for (KDCoordinate i = 0; i < rect.width(); i++) {
-      *pixel++ = color;
-      //*pixelAddress(rect.origin().translatedBy(KDPoint(i,j))) = color;
-    }
-    pixel += lineDelta;
+    KDColor::FillRow(pixel, color, rect.width());
+    pixel += m_size.width();
   }
 }
 
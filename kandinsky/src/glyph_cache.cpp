@@ -0,0 +1,70 @@
+#include <assert.h>
+#include <ion/counters.h>
+#include <kandinsky/glyph_cache.h>
+#include <string.h>
+
+#if KANDINSKY_NUMBER_OF_CACHED_GLYPHS > 0
+
+KDGlyphCache::CachedGlyph KDGlyphCache::s_glyphs[k_numberOfGlyphs];
+uint32_t KDGlyphCache::s_numberOfRequests = 0;
+
+static Ion::Counters::Counter s_hits("glyph_cache_hits");
+static Ion::Counters::Counter s_misses("glyph_cache_misses");
+
+const KDColor* KDGlyphCache::Glyph(CodePoint codePoint, KDGlyph::Style style,
+                                   const KDFont::RenderPalette* palette,
+                                   KDFont::GlyphBuffer* workingBuffer) {
+  assert(codePoint != UCodePointNull && !codePoint.isCombining());
+  s_numberOfRequests++;
+  CachedGlyph* leastRecentlyUsed = s_glyphs;
+  for (int i = 0; i < k_numberOfGlyphs; i++) {
+    CachedGlyph* glyph = s_glyphs + i;
+    if (glyph->codePoint == codePoint && glyph->font == style.font &&
+        glyph->glyphColor == style.glyphColor &&
+        glyph->backgroundColor == style.backgroundColor) {
+      s_hits.add();
+      glyph->lastUse = s_numberOfRequests;
+      return glyph->pixels;
+    }
+    /* Free slots have a lastUse of 0. Comparing ages rather than lastUse
+     * values keeps the order right when s_numberOfRequests overflows. */
+    if (s_numberOfRequests - glyph->lastUse >
+        s_numberOfRequests - leastRecentlyUsed->lastUse) {
+      leastRecentlyUsed = glyph;
+    }
+  }
+  s_misses.add();
+  const KDFont* font = KDFont::Font(style.font);
+  font->setGlyphGrayscalesForCodePoint(codePoint, workingBuffer);
+  font->colorizeGlyphBuffer(palette, workingBuffer);
+  memcpy(leastRecentlyUsed->pixels, workingBuffer->colorBuffer(),
+         KDFont::GlyphWidth(style.font) * KDFont::GlyphHeight(style.font) *
+             sizeof(KDColor));
+  leastRecentlyUsed->codePoint = codePoint;
+  leastRecentlyUsed->glyphColor = style.glyphColor;
+  leastRecentlyUsed->backgroundColor = style.backgroundColor;
+  leastRecentlyUsed->font = style.font;
+  leastRecentlyUsed->lastUse = s_numberOfRequests;
+  return leastRecentlyUsed->pixels;
+}
+
+void KDGlyphCache::Clear() {
+  for (int i = 0; i < k_numberOfGlyphs; i++) {
+    s_glyphs[i].codePoint = UCodePointNull;
+    s_glyphs[i].lastUse = 0;
+  }
+  s_numberOfRequests = 0;
+}
+
+#else
+
+const KDColor* KDGlyphCache::Glyph(CodePoint codePoint, KDGlyph::Style style,
+                                   const KDFont::RenderPalette* palette,
+                                   KDFont::GlyphBuffer* workingBuffer) {
+  assert(false);
+  return nullptr;
+}
+
+void KDGlyphCache::Clear() {}
+
+#endif
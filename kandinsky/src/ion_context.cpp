@@ -1,22 +1,113 @@
+#include <assert.h>
+#include <ion/counters.h>
 #include <ion/display.h>
 #include <kandinsky/ion_context.h>
 
 OMG::GlobalBox<KDIonContext> KDIonContext::SharedContext;
 
-KDIonContext::KDIonContext() : KDContext(KDPointZero, KDRectScreen) {}
+static Ion::Counters::Counter s_pushedRects("pushed_rects");
+static Ion::Counters::Counter s_pushedPixels("pushed_pixels");
+static Ion::Counters::Counter s_savedRects("display_list_saved_rects");
+static Ion::Counters::Counter s_savedPixels("display_list_saved_pixels");
+
+static uint32_t Area(KDRect rect) {
+  return static_cast<uint32_t>(rect.width()) * rect.height();
+}
+
+KDIonContext::KDIonContext()
+    : KDContext(KDPointZero, KDRectScreen),
+      m_numberOfRecordedFills(0),
+      m_recording(false) {}
+
+void KDIonContext::stopRecording() {
+  flushRecordedFills(m_numberOfRecordedFills);
+  m_recording = false;
+}
 
 void KDIonContext::pushRect(KDRect rect, const KDColor* pixels) {
+  if (m_numberOfRecordedFills > 0) {
+    dropRecordedFillsCoveredBy(rect);
+    if (recordedFillsIntersect(rect)) {
+      flushRecordedFills(m_numberOfRecordedFills);
+    }
+  }
+  s_pushedRects.add();
+  s_pushedPixels.add(Area(rect));
   Ion::Display::pushRect(rect, pixels);
 }
 
 void KDIonContext::pushRectUniform(KDRect rect, KDColor color) {
-  Ion::Display::pushRectUniform(rect, color);
+  if (!m_recording) {
+    s_pushedRects.add();
+    s_pushedPixels.add(Area(rect));
+    Ion::Display::pushRectUniform(rect, color);
+    return;
+  }
+  dropRecordedFillsCoveredBy(rect);
+  if (m_numberOfRecordedFills > 0) {
+    /* Only the last fill can be extended, the previous ones would otherwise be
+     * pushed over the fills recorded after them. */
+    UniformFill* last = m_recordedFills + m_numberOfRecordedFills - 1;
+    KDRect merged = last->rect.unionedWith(rect);
+    uint32_t overlap = Area(last->rect.intersectedWith(rect));
+    if (last->color == color &&
+        Area(merged) == Area(last->rect) + Area(rect) - overlap) {
+      s_savedRects.add();
+      s_savedPixels.add(overlap);
+      last->rect = merged;
+      return;
+    }
+  }
+  if (m_numberOfRecordedFills == k_maxNumberOfRecordedFills) {
+    flushRecordedFills(1);
+  }
+  m_recordedFills[m_numberOfRecordedFills++] = {rect, color};
 }
 
 void KDIonContext::pullRect(KDRect rect, KDColor* pixels) {
+  if (recordedFillsIntersect(rect)) {
+    flushRecordedFills(m_numberOfRecordedFills);
+  }
   Ion::Display::pullRect(rect, pixels);
 }
 
+void KDIonContext::dropRecordedFillsCoveredBy(KDRect rect) {
+  int numberOfKeptFills = 0;
+  for (int i = 0; i < m_numberOfRecordedFills; i++) {
+    if (rect.containsRect(m_recordedFills[i].rect)) {
+      s_savedRects.add();
+      s_savedPixels.add(Area(m_recordedFills[i].rect));
+    } else {
+      m_recordedFills[numberOfKeptFills++] = m_recordedFills[i];
+    }
+  }
+  m_numberOfRecordedFills = numberOfKeptFills;
+}
+
+bool KDIonContext::recordedFillsIntersect(KDRect rect) const {
+  for (int i = 0; i < m_numberOfRecordedFills; i++) {
+    if (m_recordedFills[i].rect.intersects(rect)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void KDIonContext::flushRecordedFills(int numberOfFills) {
+  assert(numberOfFills <= m_numberOfRecordedFills);
+  // The oldest fills are pushed first
+  for (int i = 0; i < numberOfFills; i++) {
+    s_pushedRects.add();
+    s_pushedPixels.add(Area(m_recordedFills[i].rect));
+    Ion::Display::pushRectUniform(m_recordedFills[i].rect,
+                                  m_recordedFills[i].color);
+  }
+  m_numberOfRecordedFills -= numberOfFills;
+  for (int i = 0; i < m_numberOfRecordedFills; i++) {
+    m_recordedFills[i] = m_recordedFills[i + numberOfFills];
+  }
+}
+
 static KDPoint s_cursor = KDPointZero;
 
 void KDIonContext::Putchar(char c) {
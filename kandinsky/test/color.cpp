@@ -2,6 +2,8 @@
 #include <escher/palette.h>
 #include <kandinsky/color.h>
 #include <quiz.h>
+#include <quiz/stopwatch.h>
+#include <string.h>
 
 #include <array>
 #include <cmath>
@@ -51,6 +53,77 @@ QUIZ_CASE(kandinsky_color_blend) {
   }
 }
 
+QUIZ_CASE(kandinsky_color_row_kernels) {
+  /* Rows are not a multiple of the vector width, so that both the vectorized
+   * and the scalar parts of the kernels are checked against Blend. */
+  constexpr int k_rowLength = 256 + 5;
+  KDColor colors[] = {KDColorBlack, KDColorWhite, KDColorRed,
+                      KDColor::RGB24(0x123456)};
+  uint8_t alphas[k_rowLength];
+  KDColor row[k_rowLength];
+  KDColor expected[k_rowLength];
+  for (KDColor color : colors) {
+    for (uint32_t firstPixel = 0; firstPixel <= 0xFFFF; firstPixel += 0x3F1) {
+      for (int i = 0; i < k_rowLength; i++) {
+        alphas[i] = i;
+        row[i] = KDColor::RGB16(firstPixel + 0x45 * i);
+        expected[i] = KDColor::Blend(row[i], color, alphas[i]);
+      }
+      KDColor::BlendRow(row, color, alphas, k_rowLength);
+      for (int i = 0; i < k_rowLength; i++) {
+        quiz_assert(row[i] == expected[i]);
+      }
+    }
+    KDColor::FillRow(row, color, k_rowLength - 1);
+    for (int i = 0; i < k_rowLength - 1; i++) {
+      quiz_assert(row[i] == color);
+    }
+  }
+}
+
+QUIZ_CASE(kandinsky_color_row_kernels_throughput) {
+  /* Blend 100 frames of 320x240 and fill 1000 frames, one row of 320 pixels
+   * at a time, and print the time taken by the row kernels and by Blend called
+   * on each pixel. Fills are too fast to be timed on fewer frames. */
+  constexpr int k_rowLength = 320;
+  constexpr int k_numberOfRows = 100 * 240;
+  constexpr int k_numberOfFilledRows = 10 * k_numberOfRows;
+  KDColor color = KDColor::RGB24(0x123456);
+  uint8_t alphas[k_rowLength];
+  KDColor row[k_rowLength];
+  KDColor expected[k_rowLength];
+  for (int i = 0; i < k_rowLength; i++) {
+    alphas[i] = 7 * i;
+    row[i] = KDColor::RGB16(0x45 * i);
+    expected[i] = row[i];
+  }
+
+  quiz_print("BlendRow on 100 frames");
+  uint64_t startTime = quiz_stopwatch_start();
+  for (int j = 0; j < k_numberOfRows; j++) {
+    KDColor::BlendRow(row, color, alphas, k_rowLength);
+  }
+  quiz_stopwatch_print_lap(startTime);
+
+  quiz_print("Blend on each pixel of 100 frames");
+  startTime = quiz_stopwatch_start();
+  for (int j = 0; j < k_numberOfRows; j++) {
+    for (int i = 0; i < k_rowLength; i++) {
+      expected[i] = KDColor::Blend(expected[i], color, alphas[i]);
+    }
+  }
+  quiz_stopwatch_print_lap(startTime);
+  quiz_assert(memcmp(row, expected, sizeof(row)) == 0);
+
+  quiz_print("FillRow on 1000 frames");
+  startTime = quiz_stopwatch_start();
+  for (int j = 0; j < k_numberOfFilledRows; j++) {
+    KDColor::FillRow(row, j % 2 == 0 ? color : KDColorWhite, k_rowLength);
+  }
+  quiz_stopwatch_print_lap(startTime);
+  quiz_assert(row[0] == KDColorWhite && row[k_rowLength - 1] == KDColorWhite);
+}
+
 QUIZ_CASE(kandinsky_color_hsv) {
   // Check if hsv conversion can be reverted to same color
   uint16_t c = 0;
@@ -0,0 +1,59 @@
+#include <kandinsky/glyph_cache.h>
+#include <quiz.h>
+
+#if KANDINSKY_NUMBER_OF_CACHED_GLYPHS > 0
+
+static const KDColor* assert_glyph_is_cached(
+    CodePoint codePoint, KDGlyph::Style style,
+    const KDColor* expectedAddress = nullptr) {
+  const KDFont* font = KDFont::Font(style.font);
+  KDFont::RenderPalette palette =
+      font->renderPalette(style.glyphColor, style.backgroundColor);
+  KDFont::GlyphBuffer expected;
+  font->setGlyphGrayscalesForCodePoint(codePoint, &expected);
+  font->colorizeGlyphBuffer(&palette, &expected);
+
+  KDFont::GlyphBuffer workingBuffer;
+  const KDColor* glyph =
+      KDGlyphCache::Glyph(codePoint, style, &palette, &workingBuffer);
+  quiz_assert(expectedAddress == nullptr || glyph == expectedAddress);
+  int numberOfPixels =
+      KDFont::GlyphWidth(style.font) * KDFont::GlyphHeight(style.font);
+  for (int i = 0; i < numberOfPixels; i++) {
+    quiz_assert(glyph[i] == expected.colorBuffer()[i]);
+  }
+  return glyph;
+}
+
+QUIZ_CASE(kandinsky_glyph_cache) {
+  KDGlyphCache::Clear();
+  KDGlyph::Style large = {};
+  KDGlyph::Style small = {.font = KDFont::Size::Small};
+  KDGlyph::Style red = {.glyphColor = KDColorRed};
+  KDGlyph::Style inverted = {.glyphColor = KDColorWhite,
+                             .backgroundColor = KDColorBlack};
+
+  // The same code point is cached once per style
+  const KDColor* a = assert_glyph_is_cached('a', large);
+  assert_glyph_is_cached('a', large, a);
+  assert_glyph_is_cached('a', small);
+  assert_glyph_is_cached('a', red);
+  assert_glyph_is_cached('a', inverted);
+  assert_glyph_is_cached(0x222B, large);  // ∫
+  assert_glyph_is_cached('a', large, a);
+
+  /* Fill the cache with other glyphs. Requesting 'a' again keeps it from being
+   * recycled, the least recently used glyph is recycled instead. */
+  KDGlyphCache::Clear();
+  a = assert_glyph_is_cached('a', large);
+  const KDColor* leastRecentlyUsed = assert_glyph_is_cached('0', large);
+  for (int i = 1; i < KDGlyphCache::k_numberOfGlyphs - 1; i++) {
+    assert_glyph_is_cached('0' + i, large);
+  }
+  assert_glyph_is_cached('a', large, a);
+  assert_glyph_is_cached('~', large, leastRecentlyUsed);
+  assert_glyph_is_cached('a', large, a);
+  KDGlyphCache::Clear();
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef POINCARE_APPROXIMATION_CACHE_H
+#define POINCARE_APPROXIMATION_CACHE_H
+
+#include <poincare/expression.h>
+#include <poincare/preferences.h>
+#include <stdint.h>
+
+namespace Poincare {
+
+/* The ApproximationCache memoizes the scalar approximations of expressions.
+ * Values tables, graph cursors and solvers approximate the same reduced
+ * expression over and over with identical arguments. A hit skips
+ * ExpressionNode::approximate completely.
+ *
+ * An entry is keyed by a copy of the content of the tree (which ignores the
+ * node identifiers and reference counters), the angle unit, the complex
+ * format, the approximation precision and the value of the free symbol. A hash
+ * of the content is compared first. Only expressions whose value cannot depend
+ * on the context are cached: they must not contain random nodes, functions,
+ * sequences or symbols other than the free symbol, and their content must fit
+ * in k_maxContentSize bytes.
+ *
+ * Graph sampling and solvers approximate expressions at ever changing values
+ * of the free symbol, which would always miss. The cache is only used for
+ * values of the free symbol approximated recently, so that the tree is not
+ * copied for each new value. */
+
+class ApproximationCache final {
+ public:
+  constexpr static int k_numberOfEntries = 16;
+  constexpr static int k_maxContentSize = 128;
+
+  class Key {
+    friend class ApproximationCache;
+
+   public:
+    Key()
+        : m_hash(0),
+          m_contentSize(0),
+          m_symbolValue(0),
+          m_complexFormat(Preferences::ComplexFormat::Real),
+          m_angleUnit(Preferences::AngleUnit::Radian),
+          m_isDouble(false) {}
+    bool isValid() const { return m_contentSize != 0; }
+
+   private:
+    bool operator==(const Key& other) const;
+
+    uint32_t m_hash;
+    uint16_t m_contentSize;
+    uint8_t m_content[k_maxContentSize];
+    uint64_t m_symbolValue;
+    Preferences::ComplexFormat m_complexFormat;
+    Preferences::AngleUnit m_angleUnit;
+    bool m_isDouble;
+  };
+
+  static ApproximationCache* SharedCache();
+
+  /* Returns an invalid key if the approximation of e cannot be cached.
+   * symbol is the free symbol, approximated to x, or nullptr if there is
+   * none. */
+  template <typename T>
+  static Key KeyFor(const Expression e, const char* symbol, T x,
+                    Preferences::ComplexFormat complexFormat,
+                    Preferences::AngleUnit angleUnit);
+
+  /* Returns false the first time x is approximated recently: the cache should
+   * then be skipped. */
+  template <typename T>
+  bool symbolValueWasApproximated(T x);
+  template <typename T>
+  bool find(const Key& key, T* result);
+  template <typename T>
+  void store(const Key& key, T value);
+  void reset();
+
+  int numberOfHits() const { return m_numberOfHits; }
+  int numberOfMisses() const { return m_numberOfMisses; }
+  void resetCounters() { m_numberOfHits = m_numberOfMisses = 0; }
+
+ private:
+  ApproximationCache()
+      : m_nextEntry(0),
+        m_nextSymbolValue(0),
+        m_numberOfHits(0),
+        m_numberOfMisses(0) {
+    reset();
+  }
+
+  Key m_keys[k_numberOfEntries];
+  double m_values[k_numberOfEntries];
+  // Entries are replaced in a round robin fashion
+  int m_nextEntry;
+  // Bits of the values of the free symbol approximated recently
+  uint64_t m_symbolValues[k_numberOfEntries];
+  int m_nextSymbolValue;
+  int m_numberOfHits;
+  int m_numberOfMisses;
+};
+
+}  // namespace Poincare
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef POINCARE_APPROXIMATION_PROGRAM_H
+#define POINCARE_APPROXIMATION_PROGRAM_H
+
+#include <poincare/context.h>
+#include <poincare/expression.h>
+#include <poincare/preferences.h>
+#include <stdint.h>
+
+namespace Poincare {
+
+/* An ApproximationProgram is a reduced expression of one real variable
+ * compiled into a flat stack-based program. Evaluating it skips the virtual
+ * ExpressionNode::approximate calls and the Evaluation objects they build in
+ * the pool, which makes it much cheaper than Expression::approximate when the
+ * same expression is evaluated at many abscissas, as when plotting a curve.
+ *
+ * Only the real complex format and a few common node types are handled:
+ * symbol-free subtrees are folded into constants at compilation and any other
+ * node makes the compilation fail, in which case the caller should keep on
+ * approximating the tree. Evaluations follow the semantics of the nodes'
+ * approximations: a nonreal intermediate value makes the result undefined. */
+
+template <typename T>
+class ApproximationProgram final {
+ public:
+  constexpr static int k_maxNumberOfInstructions = 48;
+  constexpr static int k_maxStackDepth = 16;
+  /* Number of abscissas evaluated side by side by the batch evaluation, which
+   * bounds the size of its stack. */
+  constexpr static int k_batchSize = 16;
+
+  ApproximationProgram()
+      : m_numberOfInstructions(0),
+        m_angleUnit(Preferences::AngleUnit::Radian) {}
+
+  bool isEmpty() const { return m_numberOfInstructions == 0; }
+  void clear() { m_numberOfInstructions = 0; }
+  /* Returns false and leaves the program empty if e cannot be compiled.
+   * symbol is the variable of the expression. */
+  bool compile(const Expression e, const char* symbol, Context* context,
+               Preferences::ComplexFormat complexFormat,
+               Preferences::AngleUnit angleUnit);
+  T evaluate(T x) const;
+  // Fills y[i] with the value of the program at x[i], for 0 <= i < n
+  void evaluate(const T* x, T* y, int n) const;
+
+ private:
+  enum class OpCode : uint8_t {
+    Constant,
+    Variable,
+    Addition,
+    Multiplication,
+    Subtraction,
+    Division,
+    Opposite,
+    Power,
+    RationalPower,
+    Sine,
+    Cosine,
+    Tangent,
+    NaperianLogarithm,
+    Logarithm,
+    AbsoluteValue,
+    SquareRoot,
+    SignFunction,
+    Dependency,
+  };
+
+  struct Instruction {
+    OpCode opCode;
+    // Number of popped values for n-ary operations
+    uint8_t arity;
+    // Value of constants, numerator and denominator of rational powers
+    T operands[2];
+  };
+
+  bool compileNode(const Expression e, const char* symbol, Context* context,
+                   Preferences::ComplexFormat complexFormat, int* stackDepth);
+  void evaluateBatch(const T* x, T* y, int n) const;
+  bool push(OpCode opCode, int arity, int* stackDepth, T operand0 = 0,
+            T operand1 = 0);
+
+  Instruction m_instructions[k_maxNumberOfInstructions];
+  int m_numberOfInstructions;
+  Preferences::AngleUnit m_angleUnit;
+};
+
+}  // namespace Poincare
+
+#endif
@@ -27,8 +27,8 @@ class DiscreteDistribution : public Distribution {
     if (y < x) {
       return 0.0f;
     }
-    return CumulativeDistributiveFunctionAtAbscissa(y, parameters) -
-           CumulativeDistributiveFunctionAtAbscissa(x - 1.0f, parameters);
+    return cumulativeDistributiveFunctionAtAbscissa(y, parameters) -
+           cumulativeDistributiveFunctionAtAbscissa(x - 1.0f, parameters);
   }
 
   double cumulativeDistributiveFunctionForRange(
@@ -36,8 +36,8 @@ class DiscreteDistribution : public Distribution {
     if (y < x) {
       return 0.0;
     }
-    return CumulativeDistributiveFunctionAtAbscissa(y, parameters) -
-           CumulativeDistributiveFunctionAtAbscissa(x - 1.0, parameters);
+    return cumulativeDistributiveFunctionAtAbscissa(y, parameters) -
+           cumulativeDistributiveFunctionAtAbscissa(x - 1.0, parameters);
   }
 };
 
@@ -20,6 +20,7 @@ class Expression : public TreeHandle {
   friend class AbsoluteValue;
   friend class Addition;
   friend class AdditionNode;
+  friend class ApproximationCache;
   friend class ArcCosecant;
   friend class ArcCosine;
   friend class ArcCotangent;
@@ -498,6 +499,14 @@ class Expression : public TreeHandle {
   U approximateWithValueForSymbol(const char* symbol, U x, Context* context,
                                   Preferences::ComplexFormat complexFormat,
                                   Preferences::AngleUnit angleUnit) const;
+  /* Fills y[i] with approximateWithValueForSymbol(symbol, x[i], ...) for
+   * 0 <= i < n. The expression is compiled once into an ApproximationProgram
+   * when possible, which is much faster than n separate approximations. */
+  template <typename U>
+  void approximateWithValuesForSymbol(const char* symbol, const U* x, U* y,
+                                      int n, Context* context,
+                                      Preferences::ComplexFormat complexFormat,
+                                      Preferences::AngleUnit angleUnit) const;
   // This also reduces the expression. Approximation is in double.
   Expression cloneAndApproximateKeepingSymbols(
       ReductionContext reductionContext) const;
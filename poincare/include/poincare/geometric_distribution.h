@@ -25,6 +25,17 @@ class GeometricDistribution final : public DiscreteDistribution {
     return EvaluateAtAbscissa<double>(x, parameters[0]);
   }
 
+  template <typename T>
+  static T CumulativeDistributiveFunctionAtAbscissa(T x, const T p);
+  float cumulativeDistributiveFunctionAtAbscissa(
+      float x, const float* parameters) const override {
+    return CumulativeDistributiveFunctionAtAbscissa<float>(x, parameters[0]);
+  }
+  double cumulativeDistributiveFunctionAtAbscissa(
+      double x, const double* parameters) const override {
+    return CumulativeDistributiveFunctionAtAbscissa<double>(x, parameters[0]);
+  }
+
   template <typename T>
   static T CumulativeDistributiveInverseForProbability(T probability, T p);
   float cumulativeDistributiveInverseForProbability(
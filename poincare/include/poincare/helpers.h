@@ -18,6 +18,11 @@ class Helpers {
   static size_t Gcd(size_t a, size_t b);
 
   static bool Rotate(uint32_t* dst, uint32_t* src, size_t len);
+  /* Sort in place with insertion sorts of 16 elements, merged in place, in
+   * O(n log(n)) comparisons and O(n log(n)^2) swaps. compare(i, j) returns
+   * true if element i is greater than element j, either strictly or not. The
+   * sort is stable if Compare is lenient with equalities (>= instead of >),
+   * and reverses equal elements otherwise. Sorted inputs take O(n). */
   static void Sort(Swap swap, Compare compare, void* context,
                    int numberOfElements);
   static bool FloatIsGreater(float xI, float xJ, bool nanIsGreatest);
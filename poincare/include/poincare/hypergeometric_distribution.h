@@ -22,6 +22,19 @@ class HypergeometricDistribution final : public DiscreteDistribution {
                                       parameters[2]);
   }
 
+  template <typename T>
+  static T CumulativeDistributiveFunctionAtAbscissa(T x, T N, T K, T n);
+  float cumulativeDistributiveFunctionAtAbscissa(
+      float x, const float *parameters) const override {
+    return CumulativeDistributiveFunctionAtAbscissa<float>(
+        x, parameters[0], parameters[1], parameters[2]);
+  }
+  double cumulativeDistributiveFunctionAtAbscissa(
+      double x, const double *parameters) const override {
+    return CumulativeDistributiveFunctionAtAbscissa<double>(
+        x, parameters[0], parameters[1], parameters[2]);
+  }
+
   template <typename T>
   static T CumulativeDistributiveInverseForProbability(T probability, T N, T K,
                                                        T n);
@@ -57,6 +70,8 @@ class HypergeometricDistribution final : public DiscreteDistribution {
   }
 
  private:
+  // log(binomial(n, k)), which does not overflow for large n
+  static double LogBinomialCoefficient(double k, double n);
   template <typename T>
   static bool NIsOK(T p);
   template <typename T>
@@ -7,6 +7,10 @@
 #include <poincare/horizontal_layout.h>
 #include <stdint.h>
 
+#ifndef POINCARE_INTEGER_MAX_NUMBER_OF_DIGITS
+#define POINCARE_INTEGER_MAX_NUMBER_OF_DIGITS 32
+#endif
+
 namespace Poincare {
 
 class ExpressionLayout;
@@ -203,11 +207,19 @@ class Integer final : public TreeHandle {
   static Expression CreateMixedFraction(const Integer &num,
                                         const Integer &denom);
 
-  constexpr static int k_maxNumberOfDigits = 32;
+  /* Simulator builds can change the size of the largest Integer with
+   * POINCARE_INTEGER_MAX_NUMBER_OF_DIGITS, to explore big-number workloads. */
+  constexpr static int k_maxNumberOfDigits =
+      POINCARE_INTEGER_MAX_NUMBER_OF_DIGITS;
+  // Digit counts and indexes are stored on uint8_t
+  static_assert(k_maxNumberOfDigits > 0 && k_maxNumberOfDigits < 127,
+                "Integer::k_maxNumberOfDigits is out of bounds");
 
  private:
-  // 1E308 < (2^32)^k_maxNumberOfDigits < 1E309
-  constexpr static int k_maxNumberOfDigitsBase10 = 309;
+  /* Smallest n such as (2^32)^k_maxNumberOfDigits < 10^n, computed with
+   * log10(2^32) < 9.63296, which gives 309 for 32 digits. */
+  constexpr static int k_maxNumberOfDigitsBase10 =
+      (k_maxNumberOfDigits * 963296 + 99999) / 100000;
   // the screen is 30 digits large.
   constexpr static int k_maxNumberOfParsedDigitsBase10 = 30;
   constexpr static int k_maxExtractableInteger = INT_MAX;
@@ -9,6 +9,10 @@ constexpr static int k_maxRegularizedGammaIterations = 1000;
 constexpr static double k_regularizedGammaPrecision = DBL_EPSILON;
 double RegularizedGammaFunction(double s, double x, double epsilon,
                                 int maxNumberOfIterations, double* result);
+// Q(s,x) = 1 - P(s,x), without cancellation when P(s,x) is close to 1
+double RegularizedUpperGammaFunction(double s, double x, double epsilon,
+                                     int maxNumberOfIterations,
+                                     double* result);
 
 }  // namespace Poincare
 
@@ -37,6 +37,13 @@ class SolverAlgorithms {
   static T CumulativeDistributiveInverseForNDefinedFunction(
       T* probability, typename Solver<T>::FunctionEvaluation f,
       const void* aux);
+  /* Same result as CumulativeDistributiveInverseForNDefinedFunction, found
+   * with O(log(k)) evaluations of the cumulative distributive function
+   * instead of summing the k first terms. */
+  template <typename T>
+  static T CumulativeDistributiveInverseForNDefinedCumulativeFunction(
+      T* probability, typename Solver<T>::FunctionEvaluation cumulative,
+      const void* aux);
   template <typename T>
   static T CumulativeDistributiveFunctionForNDefinedFunction(
       T x, typename Solver<T>::FunctionEvaluation f, const void* aux);
@@ -48,6 +55,9 @@ class SolverAlgorithms {
   static_assert(k_sqrtEps == 1.4901161193847656E-8,
                 "Wrong value for sqrt(DBL_EPSILON");
   constexpr static int k_numberOfIterationsProbability = 1000000;
+  /* Inverses found by evaluating the cumulative distributive function are not
+   * limited by the number of terms of the summation. */
+  constexpr static int k_maxCumulativeInverse = 1 << 30;
   constexpr static double k_maxProbability = 0.9999995;
 };
 
@@ -17,7 +17,8 @@
  *
  * === COMPLEXITY ===
  * There are two categories of methods:
- * - The ones which will always take the same time (like mean).
+ * - The ones which memoize the moments (like mean or variance). They are all
+ *   computed in a single traversal of the dataset.
  * - The ones which memoize sorted indexes (like median).
  *
  * If you need to compute a mean, variance, standardDeviation, or any other
@@ -31,6 +32,11 @@
  * Indeed, the object memoizes m_sortedIndex and recomputes it only if you
  * ask it to.
  * (for example, that's what we do in Apps::Statistics::Store)
+ * The first elements at cumulated weights requested since the last
+ * modification are found by a selection in linear time instead: a dataset
+ * only built to compute a median never needs sortedIndex. Several of them can
+ * be requested at once with sortedElementsAtCumulatedWeights to share the
+ * partitions of the selection.
  *
  * === ENHANCEMENTS ===
  * More statistics method could be implemented here if factorization is needed.
@@ -52,7 +58,9 @@ class StatisticsDataset {
         m_weights(weights),
         m_sortedIndex(FloatList<float>::Builder()),
         m_recomputeSortedIndex(true),
-        m_memoizedTotalWeight(NAN),
+        m_hasSelectedElements(false),
+        m_recomputeMoments(true),
+        m_isMemoized(false),
         m_lnOfValues(lnOfValues),
         m_oppositeOfValues(oppositeOfValue) {}
   StatisticsDataset(const DatasetColumn<T>* values, bool lnOfValues = false,
@@ -61,17 +69,22 @@ class StatisticsDataset {
   StatisticsDataset() : StatisticsDataset(nullptr, nullptr) {}
 
   bool isUndefined() { return m_values == nullptr; }
+  /* A memoized dataset is kept by its caller and queried many times between
+   * two modifications. Its sorted index is built on the first request instead
+   * of selecting the requested elements. */
+  void setIsMemoized() { m_isMemoized = true; }
 
   void setHasBeenModified() {
     m_recomputeSortedIndex = true;
-    m_memoizedTotalWeight = NAN;
+    m_hasSelectedElements = false;
+    m_recomputeMoments = true;
   }
   int indexAtSortedIndex(int i) const;
 
-  T totalWeight() const;
-  T weightedSum() const;
+  T totalWeight() const { return moments().totalWeight; }
+  T weightedSum() const { return moments().weightedSum; }
   T offsettedSquaredSum(T offset) const;
-  T squaredSum() const { return offsettedSquaredSum(0.0); }
+  T squaredSum() const { return moments().squaredSum; }
   // sum(value(i) - (a + b * dataset.value(i))
   T squaredSumOffsettedByLinearTransformationOfDataset(
       StatisticsDataset<T> dataset, double a, double b) const;
@@ -96,6 +109,19 @@ class StatisticsDataset {
     return indexAtCumulatedFrequency(1.0 / 2.0, upperIndex);
   }
 
+  /* Batch versions of the methods above. The weights (or frequencies) must be
+   * sorted in increasing order. */
+  constexpr static int k_maxNumberOfCumulatedWeights = 9;
+  void sortedElementsAtCumulatedFrequencies(const T* frequencies,
+                                            int numberOfFrequencies,
+                                            bool createMiddleElement,
+                                            T* results) const;
+  void sortedElementsAtCumulatedWeights(const T* weights, int numberOfWeights,
+                                        bool createMiddleElement,
+                                        T* results) const;
+  void indexesAtCumulatedWeights(const T* weights, int numberOfWeights,
+                                 int* lowerIndexes, int* upperIndexes) const;
+
  private:
   int datasetLength() const {
     assert(m_weights == nullptr || m_weights->length() == m_values->length());
@@ -103,8 +129,35 @@ class StatisticsDataset {
   }
   T valueAtIndex(int index) const;
   T weightAtIndex(int index) const;
-  T privateTotalWeight() const;
   void buildSortedIndex() const;
+  void indexesAtCumulatedWeightsInSortedIndex(const T* weights,
+                                              int numberOfWeights,
+                                              int* lowerIndexes,
+                                              int* upperIndexes) const;
+  bool selectIndexesAtCumulatedWeights(const T* weights, int numberOfWeights,
+                                       int* lowerIndexes,
+                                       int* upperIndexes) const;
+  bool selectPositionsAtCumulatedWeights(FloatList<float>* permutation,
+                                         int start, int end, T weightBefore,
+                                         const T* weights, int numberOfWeights,
+                                         int* positions, T* cumulatedWeights,
+                                         int maxDepth) const;
+  void positionsAtCumulatedWeightsInRange(FloatList<float>* permutation,
+                                          int start, int end, T weightBefore,
+                                          const T* weights,
+                                          int numberOfWeights, int* positions,
+                                          T* cumulatedWeights) const;
+
+  // Moments computed together in a single traversal of the dataset
+  struct Moments {
+    T totalWeight;
+    T weightedSum;
+    T squaredSum;
+    // Weighted sum of the squared deviations from the mean
+    T squaredDeviationSum;
+  };
+  const Moments& moments() const;
+  Moments computeMoments() const;
 
   const DatasetColumn<T>* m_values;
   const DatasetColumn<T>* m_weights;
@@ -112,7 +165,13 @@ class StatisticsDataset {
    * containing numbers in the pool.*/
   mutable FloatList<float> m_sortedIndex;
   mutable bool m_recomputeSortedIndex;
-  mutable double m_memoizedTotalWeight;
+  /* Only the first elements requested since the last modification are
+   * selected. If more are requested, the dataset is reused and sorting it once
+   * is cheaper. */
+  mutable bool m_hasSelectedElements;
+  mutable Moments m_memoizedMoments;
+  mutable bool m_recomputeMoments;
+  bool m_isMemoized;
   bool m_lnOfValues;
   bool m_oppositeOfValues;
 };
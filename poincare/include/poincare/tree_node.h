@@ -57,6 +57,10 @@ class TreeNode {
   uint16_t identifier() const { return m_identifier; }
   int retainCount() const { return m_referenceCounter; }
   size_t deepSize(int realNumberOfChildren) const;
+  /* Copies the content of the node in buffer, leaving out its identifiers and
+   * reference counter which only depend on where it lives in the pool.
+   * Returns the number of bytes copied, or 0 if they do not fit. */
+  size_t copyContent(uint8_t *buffer, size_t bufferSize) const;
 
   // Ghost
   virtual bool isGhost() const { return false; }
@@ -38,10 +38,59 @@ class TreePool final {
 #endif
   }
 
-  TreePool() : m_cursor(buffer()) {}
+#if POINCARE_TREE_STATS
+  /* Counters of the pool activity since the last resetStatistics. They are
+   * compiled in with POINCARE_TREE_STATS=1 and help sizing BufferSize and
+   * finding the simplification passes that thrash the pool. */
+  struct Statistics {
+    constexpr static int k_maxNumberOfNodeTypes = 64;
+    constexpr static int k_nodeNameSize = 32;
+    struct NodeType {
+      /* Node types are told apart by their vtable: TreeNode has no type of
+       * its own and its subclasses are not compiled with RTTI. */
+      const void *vtable;
+      char name[k_nodeNameSize];
+      int numberOfBuilds;
+      size_t builtBytes;
+    };
+
+    int numberOfAllocations;
+    size_t allocatedBytes;
+    // Bytes rotated by move and moveChildren
+    int numberOfMoves;
+    size_t movedBytes;
+    // Bytes shifted to fill the holes left by discarded nodes
+    size_t compactedBytes;
+    int numberOfPoolFullExceptions;
+    int peakNumberOfIdentifiers;
+    int numberOfNodeTypes;
+    // Nodes whose type did not fit in nodeTypes are only counted here
+    int numberOfUntypedBuilds;
+    NodeType nodeTypes[k_maxNumberOfNodeTypes];
+  };
+
+  const Statistics &statistics() const { return m_statistics; }
+  void resetStatistics();
+  int numberOfUsedIdentifiers() const {
+    return MaxNumberOfNodes - m_identifiers.numberOfAvailableIdentifiers();
+  }
+  constexpr static int NumberOfIdentifiers() { return MaxNumberOfNodes; }
+  constexpr static int Size() { return BufferSize; }
+#endif
+
+  TreePool() : m_cursor(buffer()), m_highWaterMark(buffer()) {
+#if POINCARE_TREE_STATS
+    resetStatistics();
+#endif
+  }
 
   TreeNode *cursor() const { return reinterpret_cast<TreeNode *>(m_cursor); }
 
+  /* Highest number of bytes used in the pool since the last reset. It is used
+   * by the simulator benchmark to size the pool needs of a scenario. */
+  size_t highWaterMark() const { return m_highWaterMark - constBuffer(); }
+  void resetHighWaterMark() { m_highWaterMark = m_cursor; }
+
   // Node
   TreeNode *node(uint16_t identifier) const {
     assert(TreeNode::IsValidIdentifier(identifier) &&
@@ -148,7 +197,17 @@ class TreePool final {
   void moveNodes(TreeNode *destination, TreeNode *source, size_t moveLength);
 
   // Identifiers
-  uint16_t generateIdentifier() { return m_identifiers.pop(); }
+  uint16_t generateIdentifier() {
+#if POINCARE_TREE_STATS
+    uint16_t identifier = m_identifiers.pop();
+    if (numberOfUsedIdentifiers() > m_statistics.peakNumberOfIdentifiers) {
+      m_statistics.peakNumberOfIdentifiers = numberOfUsedIdentifiers();
+    }
+    return identifier;
+#else
+    return m_identifiers.pop();
+#endif
+  }
   void freeIdentifier(uint16_t identifier);
 
   class IdentifierStack final {
@@ -159,6 +218,7 @@ class TreePool final {
     uint16_t pop();
     void remove(uint16_t j);
     void resetNodeForIdentifierOffsets(uint16_t *nodeForIdentifierOffset) const;
+    int numberOfAvailableIdentifiers() const { return m_currentIndex; }
 
    private:
     uint16_t m_currentIndex;
@@ -170,13 +230,21 @@ class TreePool final {
 
   void freePoolFromNode(TreeNode *firstNodeToDiscard);
 
+#if POINCARE_TREE_STATS
+  void recordBuild(const TreeNode *node);
+#endif
+
   char *buffer() { return reinterpret_cast<char *>(m_alignedBuffer); }
   const char *constBuffer() const {
     return reinterpret_cast<const char *>(m_alignedBuffer);
   }
   AlignedNodeBuffer m_alignedBuffer[BufferSize / ByteAlignment];
   char *m_cursor;
+  char *m_highWaterMark;
   IdentifierStack m_identifiers;
+#if POINCARE_TREE_STATS
+  Statistics m_statistics;
+#endif
   uint16_t m_nodeForIdentifierOffset[MaxNumberOfNodes];
   static_assert(k_maxNodeOffset < UINT16_MAX &&
                     sizeof(m_nodeForIdentifierOffset[0]) == sizeof(uint16_t),
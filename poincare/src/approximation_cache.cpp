@@ -0,0 +1,142 @@
+#include <poincare/approximation_cache.h>
+#include <poincare/expression_node.h>
+#include <poincare/symbol_abstract.h>
+#include <string.h>
+
+namespace Poincare {
+
+bool ApproximationCache::Key::operator==(const Key& other) const {
+  return m_hash == other.m_hash && m_contentSize == other.m_contentSize &&
+         m_symbolValue == other.m_symbolValue &&
+         m_complexFormat == other.m_complexFormat &&
+         m_angleUnit == other.m_angleUnit && m_isDouble == other.m_isDouble &&
+         memcmp(m_content, other.m_content, m_contentSize) == 0;
+}
+
+ApproximationCache* ApproximationCache::SharedCache() {
+  static ApproximationCache s_cache;
+  return &s_cache;
+}
+
+static bool IsCacheable(const ExpressionNode* node, const char* symbol) {
+  if (node->isRandom() || node->type() == ExpressionNode::Type::Function ||
+      node->type() == ExpressionNode::Type::Sequence) {
+    return false;
+  }
+  if (node->type() == ExpressionNode::Type::Symbol) {
+    /* Any other symbol, including the parameter of a parametered expression,
+     * may be defined by the context. */
+    return symbol != nullptr &&
+           strcmp(static_cast<const SymbolAbstractNode*>(node)->name(),
+                  symbol) == 0;
+  }
+  return true;
+}
+
+template <typename T>
+ApproximationCache::Key ApproximationCache::KeyFor(
+    const Expression e, const char* symbol, T x,
+    Preferences::ComplexFormat complexFormat,
+    Preferences::AngleUnit angleUnit) {
+  Key key;
+  if (e.isUninitialized()) {
+    return key;
+  }
+  const ExpressionNode* root = e.node();
+  if (!IsCacheable(root, symbol)) {
+    return key;
+  }
+  size_t contentSize = root->copyContent(key.m_content, k_maxContentSize);
+  if (contentSize == 0) {
+    return key;
+  }
+  for (const TreeNode* node : root->depthFirstChildren()) {
+    if (!IsCacheable(static_cast<const ExpressionNode*>(node), symbol)) {
+      return key;
+    }
+    size_t nodeContentSize = node->copyContent(
+        key.m_content + contentSize, k_maxContentSize - contentSize);
+    if (nodeContentSize == 0) {
+      return key;
+    }
+    contentSize += nodeContentSize;
+  }
+  // FNV-1a hash of the content
+  constexpr uint32_t k_fnvOffsetBasis = 2166136261;
+  constexpr uint32_t k_fnvPrime = 16777619;
+  uint32_t hash = k_fnvOffsetBasis;
+  for (size_t i = 0; i < contentSize; i++) {
+    hash = (hash ^ key.m_content[i]) * k_fnvPrime;
+  }
+  key.m_hash = hash;
+  key.m_contentSize = contentSize;
+  /* Values are compared bitwise so that 0 and -0 are told apart and NaN can
+   * be matched. */
+  double value = symbol != nullptr ? static_cast<double>(x) : 0.0;
+  memcpy(&key.m_symbolValue, &value, sizeof(value));
+  key.m_complexFormat = complexFormat;
+  key.m_angleUnit = angleUnit;
+  key.m_isDouble = sizeof(T) == sizeof(double);
+  return key;
+}
+
+template <typename T>
+bool ApproximationCache::symbolValueWasApproximated(T x) {
+  double value = static_cast<double>(x);
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(value));
+  for (int i = 0; i < k_numberOfEntries; i++) {
+    if (m_symbolValues[i] == bits) {
+      return true;
+    }
+  }
+  m_symbolValues[m_nextSymbolValue] = bits;
+  m_nextSymbolValue = (m_nextSymbolValue + 1) % k_numberOfEntries;
+  return false;
+}
+
+template <typename T>
+bool ApproximationCache::find(const Key& key, T* result) {
+  assert(key.isValid());
+  for (int i = 0; i < k_numberOfEntries; i++) {
+    if (m_keys[i] == key) {
+      m_numberOfHits++;
+      *result = static_cast<T>(m_values[i]);
+      return true;
+    }
+  }
+  m_numberOfMisses++;
+  return false;
+}
+
+template <typename T>
+void ApproximationCache::store(const Key& key, T value) {
+  assert(key.isValid());
+  m_keys[m_nextEntry] = key;
+  m_values[m_nextEntry] = static_cast<double>(value);
+  m_nextEntry = (m_nextEntry + 1) % k_numberOfEntries;
+}
+
+void ApproximationCache::reset() {
+  for (int i = 0; i < k_numberOfEntries; i++) {
+    m_keys[i] = Key();
+    m_symbolValues[i] = 0;
+  }
+  m_nextEntry = 0;
+  m_nextSymbolValue = 0;
+}
+
+template ApproximationCache::Key ApproximationCache::KeyFor<float>(
+    const Expression, const char*, float, Preferences::ComplexFormat,
+    Preferences::AngleUnit);
+template ApproximationCache::Key ApproximationCache::KeyFor<double>(
+    const Expression, const char*, double, Preferences::ComplexFormat,
+    Preferences::AngleUnit);
+template bool ApproximationCache::symbolValueWasApproximated<float>(float);
+template bool ApproximationCache::symbolValueWasApproximated<double>(double);
+template bool ApproximationCache::find<float>(const Key&, float*);
+template bool ApproximationCache::find<double>(const Key&, double*);
+template void ApproximationCache::store<float>(const Key&, float);
+template void ApproximationCache::store<double>(const Key&, double);
+
+}  // namespace Poincare
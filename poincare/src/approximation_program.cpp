@@ -0,0 +1,443 @@
+#include <poincare/approximation_helper.h>
+#include <poincare/approximation_program.h>
+#include <poincare/dependency.h>
+#include <poincare/rational.h>
+#include <poincare/symbol.h>
+#include <poincare/trigonometry.h>
+#include <string.h>
+
+#include <cmath>
+#include <complex>
+
+namespace Poincare {
+
+static bool IsNotCompilable(const Expression e, Context* context,
+                            void* symbol) {
+  return e.isRandom() ||
+         e.isOfType({ExpressionNode::Type::Function,
+                     ExpressionNode::Type::Sequence}) ||
+         (e.type() == ExpressionNode::Type::Symbol &&
+          strcmp(static_cast<const Symbol&>(e).name(),
+                 static_cast<const char*>(symbol)) != 0);
+}
+
+template <typename T>
+bool ApproximationProgram<T>::compile(const Expression e, const char* symbol,
+                                      Context* context,
+                                      Preferences::ComplexFormat complexFormat,
+                                      Preferences::AngleUnit angleUnit) {
+  clear();
+  m_angleUnit = angleUnit;
+  if (e.isUninitialized() ||
+      complexFormat != Preferences::ComplexFormat::Real ||
+      e.recursivelyMatches(IsNotCompilable, context,
+                           SymbolicComputation::DoNotReplaceAnySymbol,
+                           const_cast<char*>(symbol))) {
+    return false;
+  }
+  int stackDepth = 0;
+  if (!compileNode(e, symbol, context, complexFormat, &stackDepth)) {
+    clear();
+    return false;
+  }
+  assert(stackDepth == 1);
+  return true;
+}
+
+template <typename T>
+bool ApproximationProgram<T>::push(OpCode opCode, int arity, int* stackDepth,
+                                   T operand0, T operand1) {
+  assert(*stackDepth >= arity);
+  if (m_numberOfInstructions >= k_maxNumberOfInstructions) {
+    return false;
+  }
+  *stackDepth += 1 - arity;
+  if (*stackDepth > k_maxStackDepth) {
+    return false;
+  }
+  m_instructions[m_numberOfInstructions++] = {
+      opCode, static_cast<uint8_t>(arity), {operand0, operand1}};
+  return true;
+}
+
+template <typename T>
+bool ApproximationProgram<T>::compileNode(
+    const Expression e, const char* symbol, Context* context,
+    Preferences::ComplexFormat complexFormat, int* stackDepth) {
+  /* recursivelyMatches does not look into the dependencies, which are
+   * compiled separately. */
+  if (e.type() != ExpressionNode::Type::Dependency &&
+      !e.recursivelyMatches(Expression::IsSymbolic, context,
+                            SymbolicComputation::DoNotReplaceAnySymbol)) {
+    if (e.recursivelyMatches(Expression::IsRandom, context)) {
+      return false;
+    }
+    // Fold the subtrees that do not depend on the variable
+    T value = e.approximateToScalar<T>(context, complexFormat, m_angleUnit);
+    return !std::isnan(value) && push(OpCode::Constant, 0, stackDepth, value);
+  }
+  int n = e.numberOfChildren();
+  OpCode opCode;
+  switch (e.type()) {
+    case ExpressionNode::Type::Symbol:
+      return strcmp(static_cast<const Symbol&>(e).name(), symbol) == 0 &&
+             push(OpCode::Variable, 0, stackDepth);
+    case ExpressionNode::Type::Dependency: {
+      Expression dependencies =
+          e.childAtIndex(Dependency::k_indexOfDependenciesList);
+      if (dependencies.type() != ExpressionNode::Type::List ||
+          !compileNode(e.childAtIndex(Dependency::k_indexOfMainExpression),
+                       symbol, context, complexFormat, stackDepth)) {
+        return false;
+      }
+      int numberOfDependencies = dependencies.numberOfChildren();
+      for (int i = 0; i < numberOfDependencies; i++) {
+        if (!compileNode(dependencies.childAtIndex(i), symbol, context,
+                         complexFormat, stackDepth)) {
+          return false;
+        }
+      }
+      return push(OpCode::Dependency, numberOfDependencies + 1, stackDepth);
+    }
+    case ExpressionNode::Type::Power: {
+      /* As in PowerNode::templatedApproximate, look for a rational index to
+       * find real roots which are not principal. */
+      Expression index = e.childAtIndex(1);
+      T p = NAN;
+      T q = NAN;
+      if (index.type() == ExpressionNode::Type::Rational) {
+        p = static_cast<Rational&>(index).signedIntegerNumerator()
+                .approximate<T>();
+        q = static_cast<Rational&>(index).integerDenominator().approximate<T>();
+      } else if (index.type() == ExpressionNode::Type::Division &&
+                 index.childAtIndex(0).type() ==
+                     ExpressionNode::Type::Rational &&
+                 index.childAtIndex(1).type() ==
+                     ExpressionNode::Type::Rational) {
+        Expression pExpression = index.childAtIndex(0);
+        Expression qExpression = index.childAtIndex(1);
+        Rational& pRational = static_cast<Rational&>(pExpression);
+        Rational& qRational = static_cast<Rational&>(qExpression);
+        if (pRational.integerDenominator().isOne() &&
+            qRational.integerDenominator().isOne()) {
+          p = pRational.signedIntegerNumerator().approximate<T>();
+          q = qRational.signedIntegerNumerator().approximate<T>();
+        }
+      }
+      if (!std::isnan(p) && !std::isnan(q)) {
+        return compileNode(e.childAtIndex(0), symbol, context, complexFormat,
+                           stackDepth) &&
+               push(OpCode::RationalPower, 1, stackDepth, p, q);
+      }
+      opCode = OpCode::Power;
+      break;
+    }
+    case ExpressionNode::Type::Addition:
+      opCode = OpCode::Addition;
+      break;
+    case ExpressionNode::Type::Multiplication:
+      opCode = OpCode::Multiplication;
+      break;
+    case ExpressionNode::Type::Subtraction:
+      opCode = OpCode::Subtraction;
+      break;
+    case ExpressionNode::Type::Division:
+      opCode = OpCode::Division;
+      break;
+    case ExpressionNode::Type::Opposite:
+      opCode = OpCode::Opposite;
+      break;
+    case ExpressionNode::Type::Sine:
+      opCode = OpCode::Sine;
+      break;
+    case ExpressionNode::Type::Cosine:
+      opCode = OpCode::Cosine;
+      break;
+    case ExpressionNode::Type::Tangent:
+      opCode = OpCode::Tangent;
+      break;
+    case ExpressionNode::Type::NaperianLogarithm:
+      opCode = OpCode::NaperianLogarithm;
+      break;
+    case ExpressionNode::Type::Logarithm:
+      if (n == 2 && Preferences::sharedPreferences->examMode()
+                        .forbidBasedLogarithm()) {
+        return false;
+      }
+      opCode = OpCode::Logarithm;
+      break;
+    case ExpressionNode::Type::AbsoluteValue:
+      opCode = OpCode::AbsoluteValue;
+      break;
+    case ExpressionNode::Type::SquareRoot:
+      opCode = OpCode::SquareRoot;
+      break;
+    case ExpressionNode::Type::SignFunction:
+      opCode = OpCode::SignFunction;
+      break;
+    default:
+      return false;
+  }
+  for (int i = 0; i < n; i++) {
+    if (!compileNode(e.childAtIndex(i), symbol, context, complexFormat,
+                     stackDepth)) {
+      return false;
+    }
+  }
+  return push(opCode, n, stackDepth);
+}
+
+/* Returns the value of a complex built by a node approximation, or NAN if it
+ * is undefined or nonreal, in which case nonreal is set like
+ * Expression::SetEncounteredComplex would be. */
+template <typename T>
+static T RealPart(std::complex<T> c, bool* nonreal) {
+  if (!std::isnan(c.imag()) && c.imag() != static_cast<T>(0.0)) {
+    *nonreal = true;
+    return NAN;
+  }
+  return std::isnan(c.imag()) ? NAN : c.real();
+}
+
+template <typename T>
+static T NeglectedRealPart(std::complex<T> result, std::complex<T> input,
+                           bool* nonreal) {
+  return RealPart(
+      ApproximationHelper::NeglectRealOrImaginaryPartIfNeglectable(result,
+                                                                   input),
+      nonreal);
+}
+
+// Mirrors LogarithmNode::computeOnComplex
+template <typename T>
+static T Log10(T c, bool* nonreal) {
+  return c == static_cast<T>(0.0)
+             ? NAN
+             : RealPart(std::log10(std::complex<T>(c)), nonreal);
+}
+
+// Mirrors PowerNode::computeOnComplex in the real complex format
+template <typename T>
+static T RealPower(T c, T d, bool* nonreal) {
+  if (std::isnan(c) || std::isnan(d)) {
+    return NAN;
+  }
+  if (c < static_cast<T>(0.0) &&
+      ((d == INFINITY && c <= static_cast<T>(-1.0)) ||
+       (d == -INFINITY && c >= static_cast<T>(-1.0)))) {
+    return NAN;
+  }
+  if (c != static_cast<T>(0.0) &&
+      (c > static_cast<T>(0.0) || std::round(d) == d)) {
+#if !PLATFORM_DEVICE
+    if (std::fabs(c) == static_cast<T>(1.0) && std::fabs(d) == INFINITY) {
+      return NAN;
+    }
+#endif
+    return std::pow(c, d);
+  }
+  std::complex<T> result = std::pow(std::complex<T>(c), std::complex<T>(d));
+  std::complex<T> precision = d < static_cast<T>(0.0)
+                                  ? std::pow(std::complex<T>(c),
+                                             static_cast<T>(-1.0))
+                                  : std::complex<T>(c);
+  return RealPart(ApproximationHelper::NeglectRealOrImaginaryPartIfNeglectable(
+                      result, precision, std::complex<T>(d), false),
+                  nonreal);
+}
+
+// Mirrors PowerNode::computeNotPrincipalRealRootOfRationalPow
+template <typename T>
+static T RationalPower(T c, T p, T q, bool* nonreal) {
+  if (std::pow(static_cast<T>(-1.0), q) < static_cast<T>(0.0)) {
+    bool absNonreal = false;
+    T absCPowD = RealPower(std::fabs(c), p / q, &absNonreal);
+    if (!std::isnan(absCPowD)) {
+      return c < static_cast<T>(0.0) &&
+                     std::pow(static_cast<T>(-1.0), p) < static_cast<T>(0.0)
+                 ? -absCPowD
+                 : absCPowD;
+    }
+  }
+  return RealPower(c, p / q, nonreal);
+}
+
+template <typename T>
+T ApproximationProgram<T>::evaluate(T x) const {
+  T y;
+  evaluate(&x, &y, 1);
+  return y;
+}
+
+template <typename T>
+void ApproximationProgram<T>::evaluate(const T* x, T* y, int n) const {
+  assert(!isEmpty());
+  for (int start = 0; start < n; start += k_batchSize) {
+    evaluateBatch(x + start, y + start,
+                  n - start < k_batchSize ? n - start : k_batchSize);
+  }
+}
+
+template <typename T>
+void ApproximationProgram<T>::evaluateBatch(const T* x, T* y, int n) const {
+  assert(n <= k_batchSize);
+  /* Each instruction is applied to the n lanes before moving on to the next
+   * one, so that the loops of arithmetic instructions can be vectorized. */
+  T stack[k_maxStackDepth][k_batchSize];
+  bool nonreal[k_batchSize];
+  for (int l = 0; l < n; l++) {
+    nonreal[l] = false;
+  }
+  int top = 0;
+  for (int i = 0; i < m_numberOfInstructions; i++) {
+    const Instruction& instruction = m_instructions[i];
+    int first = top - instruction.arity;
+    T* a = stack[first];
+    switch (instruction.opCode) {
+      case OpCode::Constant:
+        for (int l = 0; l < n; l++) {
+          a[l] = instruction.operands[0];
+        }
+        break;
+      case OpCode::Variable:
+        for (int l = 0; l < n; l++) {
+          a[l] = x[l];
+        }
+        break;
+      case OpCode::Addition:
+        for (int j = 1; j < instruction.arity; j++) {
+          const T* b = stack[first + j];
+          for (int l = 0; l < n; l++) {
+            a[l] += b[l];
+          }
+        }
+        break;
+      case OpCode::Multiplication:
+        for (int j = 1; j < instruction.arity; j++) {
+          const T* b = stack[first + j];
+          for (int l = 0; l < n; l++) {
+            a[l] *= b[l];
+          }
+        }
+        break;
+      case OpCode::Subtraction: {
+        const T* b = stack[first + 1];
+        for (int l = 0; l < n; l++) {
+          a[l] -= b[l];
+        }
+        break;
+      }
+      case OpCode::Division: {
+        const T* b = stack[first + 1];
+        for (int l = 0; l < n; l++) {
+          a[l] = b[l] == static_cast<T>(0.0) ? NAN : a[l] / b[l];
+        }
+        break;
+      }
+      case OpCode::Opposite:
+        for (int l = 0; l < n; l++) {
+          a[l] = -a[l];
+        }
+        break;
+      case OpCode::Power: {
+        const T* b = stack[first + 1];
+        for (int l = 0; l < n; l++) {
+          a[l] = RealPower(a[l], b[l], nonreal + l);
+        }
+        break;
+      }
+      case OpCode::RationalPower:
+        for (int l = 0; l < n; l++) {
+          a[l] = RationalPower(a[l], instruction.operands[0],
+                               instruction.operands[1], nonreal + l);
+        }
+        break;
+      case OpCode::Sine:
+        for (int l = 0; l < n; l++) {
+          std::complex<T> angle = Trigonometry::ConvertToRadian(
+              std::complex<T>(a[l]), m_angleUnit);
+          a[l] = NeglectedRealPart(std::sin(angle), angle, nonreal + l);
+        }
+        break;
+      case OpCode::Cosine:
+        for (int l = 0; l < n; l++) {
+          std::complex<T> angle = Trigonometry::ConvertToRadian(
+              std::complex<T>(a[l]), m_angleUnit);
+          a[l] = NeglectedRealPart(std::cos(angle), angle, nonreal + l);
+        }
+        break;
+      case OpCode::Tangent:
+        // As in TangentNode::computeOnComplex, tan is undefined when sin is ±1
+        for (int l = 0; l < n; l++) {
+          std::complex<T> angle = Trigonometry::ConvertToRadian(
+              std::complex<T>(a[l]), m_angleUnit);
+          std::complex<T> sin = std::sin(angle);
+          std::complex<T> tan =
+              sin == std::complex<T>(1) || sin == std::complex<T>(-1)
+                  ? std::complex<T>(NAN, NAN)
+                  : std::tan(angle);
+          a[l] = NeglectedRealPart(tan, angle, nonreal + l);
+        }
+        break;
+      case OpCode::NaperianLogarithm:
+        for (int l = 0; l < n; l++) {
+          a[l] = a[l] == static_cast<T>(0.0)
+                     ? NAN
+                     : RealPart(std::log(std::complex<T>(a[l])), nonreal + l);
+        }
+        break;
+      case OpCode::Logarithm:
+        for (int l = 0; l < n; l++) {
+          a[l] = Log10(a[l], nonreal + l);
+        }
+        if (instruction.arity == 2) {
+          // As in LogarithmNode::templatedApproximate, log(x,n)=log(x)/log(n)
+          const T* b = stack[first + 1];
+          for (int l = 0; l < n; l++) {
+            T base = Log10(b[l], nonreal + l);
+            a[l] = base == static_cast<T>(0.0) ? NAN : a[l] / base;
+          }
+        }
+        break;
+      case OpCode::AbsoluteValue:
+        for (int l = 0; l < n; l++) {
+          a[l] = std::fabs(a[l]);
+        }
+        break;
+      case OpCode::SignFunction:
+        for (int l = 0; l < n; l++) {
+          a[l] = std::isnan(a[l])                  ? NAN
+                 : a[l] == static_cast<T>(0.0)     ? static_cast<T>(0.0)
+                 : a[l] < static_cast<T>(0.0)      ? static_cast<T>(-1.0)
+                                                   : static_cast<T>(1.0);
+        }
+        break;
+      case OpCode::SquareRoot:
+        for (int l = 0; l < n; l++) {
+          std::complex<T> c(a[l]);
+          a[l] = NeglectedRealPart(std::sqrt(c), c, nonreal + l);
+        }
+        break;
+      default:
+        assert(instruction.opCode == OpCode::Dependency);
+        for (int j = 1; j < instruction.arity; j++) {
+          const T* b = stack[first + j];
+          for (int l = 0; l < n; l++) {
+            if (std::isnan(b[l])) {
+              a[l] = NAN;
+            }
+          }
+        }
+    }
+    top = first + 1;
+  }
+  assert(top == 1);
+  for (int l = 0; l < n; l++) {
+    y[l] = nonreal[l] ? NAN : stack[0][l];
+  }
+}
+
+template class ApproximationProgram<float>;
+template class ApproximationProgram<double>;
+
+}  // namespace Poincare
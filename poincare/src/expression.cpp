@@ -2,6 +2,8 @@
 #include <ion.h>
 #include <ion/unicode/utf8_helper.h>
 #include <poincare/addition.h>
+#include <poincare/approximation_cache.h>
+#include <poincare/approximation_program.h>
 #include <poincare/based_integer.h>
 #include <poincare/code_point_layout.h>
 #include <poincare/complex_cartesian.h>
@@ -74,8 +76,10 @@ Expression Expression::ExpressionFromAddress(const void *address, size_t size) {
     return Expression();
   }
   // Build the Expression in the Tree Pool
-  return Expression(static_cast<ExpressionNode *>(
-      TreePool::sharedPool->copyTreeFromAddress(address, size)));
+  TreeNode *node = TreePool::sharedPool->copyTreeFromAddress(address, size);
+  // The tree may be a child of the stored expression
+  node->deleteParentIdentifier();
+  return Expression(static_cast<ExpressionNode *>(node));
 }
 
 /* Hierarchy */
@@ -1623,9 +1627,23 @@ U Expression::approximateToScalar(Context *context,
                                   Preferences::ComplexFormat complexFormat,
                                   Preferences::AngleUnit angleUnit,
                                   bool withinReduce) const {
-  return approximateToEvaluation<U>(context, complexFormat, angleUnit,
-                                    withinReduce)
-      .toScalar();
+  if (withinReduce) {
+    return approximateToEvaluation<U>(context, complexFormat, angleUnit, true)
+        .toScalar();
+  }
+  ApproximationCache::Key key = ApproximationCache::KeyFor<U>(
+      *this, nullptr, U(), complexFormat, angleUnit);
+  U result;
+  if (key.isValid() &&
+      ApproximationCache::SharedCache()->find(key, &result)) {
+    return result;
+  }
+  result = approximateToEvaluation<U>(context, complexFormat, angleUnit, false)
+               .toScalar();
+  if (key.isValid()) {
+    ApproximationCache::SharedCache()->store(key, result);
+  }
+  return result;
 }
 
 template <typename U>
@@ -1647,9 +1665,41 @@ U Expression::approximateWithValueForSymbol(
     const char *symbol, U x, Context *context,
     Preferences::ComplexFormat complexFormat,
     Preferences::AngleUnit angleUnit) const {
+  ApproximationCache *cache = ApproximationCache::SharedCache();
+  ApproximationCache::Key key;
+  if (cache->symbolValueWasApproximated(x)) {
+    key = ApproximationCache::KeyFor<U>(*this, symbol, x, complexFormat,
+                                        angleUnit);
+  }
+  U result;
+  if (key.isValid() && cache->find(key, &result)) {
+    return result;
+  }
   VariableContext variableContext = VariableContext(symbol, context);
   variableContext.setApproximationForVariable<U>(x);
-  return approximateToScalar<U>(&variableContext, complexFormat, angleUnit);
+  result = approximateToEvaluation<U>(&variableContext, complexFormat,
+                                      angleUnit, false)
+               .toScalar();
+  if (key.isValid()) {
+    cache->store(key, result);
+  }
+  return result;
+}
+
+template <typename U>
+void Expression::approximateWithValuesForSymbol(
+    const char *symbol, const U *x, U *y, int n, Context *context,
+    Preferences::ComplexFormat complexFormat,
+    Preferences::AngleUnit angleUnit) const {
+  ApproximationProgram<U> program;
+  if (program.compile(*this, symbol, context, complexFormat, angleUnit)) {
+    program.evaluate(x, y, n);
+    return;
+  }
+  for (int i = 0; i < n; i++) {
+    y[i] = approximateWithValueForSymbol<U>(symbol, x[i], context,
+                                            complexFormat, angleUnit);
+  }
 }
 
 Expression Expression::cloneAndApproximateKeepingSymbols(
@@ -1999,6 +2049,14 @@ template double Expression::approximateWithValueForSymbol(
     const char *symbol, double x, Context *context,
     Preferences::ComplexFormat complexFormat,
     Preferences::AngleUnit angleUnit) const;
+template void Expression::approximateWithValuesForSymbol(
+    const char *symbol, const float *x, float *y, int n, Context *context,
+    Preferences::ComplexFormat complexFormat,
+    Preferences::AngleUnit angleUnit) const;
+template void Expression::approximateWithValuesForSymbol(
+    const char *symbol, const double *x, double *y, int n, Context *context,
+    Preferences::ComplexFormat complexFormat,
+    Preferences::AngleUnit angleUnit) const;
 
 template Expression Expression::approximateKeepingUnits<double>(
     const ReductionContext &reductionContext) const;
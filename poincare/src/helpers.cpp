@@ -2,6 +2,7 @@
 #include <poincare/helpers.h>
 #include <poincare/list.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "poincare/point.h"
@@ -101,17 +102,141 @@ bool Helpers::Rotate(uint32_t *dst, uint32_t *src, size_t len) {
   return true;
 }
 
+namespace {
+
+/* The sort only swaps and compares elements at given indexes. An element is
+ * moved before a previous one only if it is not greater than it, so that
+ * equal elements keep their order if Compare is lenient with equalities. */
+class Sorter {
+ public:
+  Sorter(Helpers::Swap swap, Helpers::Compare compare, void *context,
+         int numberOfElements)
+      : m_swap(swap),
+        m_compare(compare),
+        m_context(context),
+        m_numberOfElements(numberOfElements) {}
+
+  void insertionSort(int start, int end) {
+    for (int i = start + 1; i < end; i++) {
+      for (int j = i; j > start && goesBefore(j, j - 1); j--) {
+        swap(j, j - 1);
+      }
+    }
+  }
+
+  /* Merge the sorted ranges [start, middle) and [middle, end) in place: the
+   * second range is split so that both its halves can be swapped with a
+   * rotation, and each side is merged recursively. */
+  void merge(int start, int middle, int end) {
+    if (middle - start == 1) {
+      // Insert the first element before the first element it goes before
+      int i = middle;
+      int j = end;
+      while (i < j) {
+        int h = (i + j) / 2;
+        if (goesBefore(h, start)) {
+          i = h + 1;
+        } else {
+          j = h;
+        }
+      }
+      for (int k = start; k < i - 1; k++) {
+        swap(k, k + 1);
+      }
+      return;
+    }
+    if (end - middle == 1) {
+      // Insert the last element after the last element it does not go before
+      int i = start;
+      int j = middle;
+      while (i < j) {
+        int h = (i + j) / 2;
+        if (!goesBefore(middle, h)) {
+          i = h + 1;
+        } else {
+          j = h;
+        }
+      }
+      for (int k = middle; k > i; k--) {
+        swap(k, k - 1);
+      }
+      return;
+    }
+    int half = (start + end) / 2;
+    int n = half + middle;
+    int first = middle > half ? n - end : start;
+    int last = middle > half ? half : middle;
+    while (first < last) {
+      int c = (first + last) / 2;
+      if (!goesBefore(n - 1 - c, c)) {
+        first = c + 1;
+      } else {
+        last = c;
+      }
+    }
+    int stop = n - first;
+    if (first < middle && middle < stop) {
+      rotate(first, middle, stop);
+    }
+    if (start < first && first < half) {
+      merge(start, first, half);
+    }
+    if (half < stop && stop < end) {
+      merge(half, stop, end);
+    }
+  }
+
+ private:
+  void swap(int i, int j) { m_swap(i, j, m_context, m_numberOfElements); }
+  // Element i comes after element j and has to be moved before it
+  bool goesBefore(int i, int j) {
+    return !m_compare(i, j, m_context, m_numberOfElements);
+  }
+  // Swap [start, middle) and [middle, end) with block swaps
+  void rotate(int start, int middle, int end) {
+    int i = middle - start;
+    int j = end - middle;
+    while (i != j) {
+      if (i > j) {
+        swapRanges(middle - i, middle, j);
+        i -= j;
+      } else {
+        swapRanges(middle - i, middle + j - i, i);
+        j -= i;
+      }
+    }
+    swapRanges(middle - i, middle, i);
+  }
+  void swapRanges(int i, int j, int length) {
+    for (int k = 0; k < length; k++) {
+      swap(i + k, j + k);
+    }
+  }
+
+  Helpers::Swap m_swap;
+  Helpers::Compare m_compare;
+  void *m_context;
+  int m_numberOfElements;
+};
+
+constexpr int k_insertionSortBlockLength = 16;
+
+}  // namespace
+
 void Helpers::Sort(Swap swap, Compare compare, void *context,
                    int numberOfElements) {
-  /* Using an insertion-sort algorithm, which has the advantage of being
-   * in-place and efficient when already sorted. It is optimal if Compare is
-   * more lenient with equalities ( >= instead of > ) */
-  for (int i = 1; i < numberOfElements; i++) {
-    for (int j = i - 1; j >= 0; j--) {
-      if (compare(j + 1, j, context, numberOfElements)) {
-        break;
-      }
-      swap(j, j + 1, context, numberOfElements);
+  Sorter sorter(swap, compare, context, numberOfElements);
+  for (int start = 0; start < numberOfElements;
+       start += k_insertionSortBlockLength) {
+    sorter.insertionSort(
+        start, std::min(start + k_insertionSortBlockLength, numberOfElements));
+  }
+  for (int length = k_insertionSortBlockLength; length < numberOfElements;
+       length *= 2) {
+    for (int start = 0; start + length < numberOfElements;
+         start += 2 * length) {
+      sorter.merge(start, start + length,
+                   std::min(start + 2 * length, numberOfElements));
     }
   }
 }
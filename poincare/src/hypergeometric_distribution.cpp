@@ -31,6 +31,62 @@ T HypergeometricDistribution::EvaluateAtAbscissa(T k, T N, T K, T n) {
          BinomialCoefficientNode::compute(n, N);
 }
 
+template <typename T>
+T HypergeometricDistribution::CumulativeDistributiveFunctionAtAbscissa(T x, T N,
+                                                                       T K,
+                                                                       T n) {
+  if (!NIsOK(N) || !KIsOK(K) || !nIsOK(n) || std::isnan(x)) {
+    return NAN;
+  }
+  if (std::isinf(x)) {
+    return x > static_cast<T>(0.0) ? static_cast<T>(1.0) : static_cast<T>(0.0);
+  }
+  if (x < static_cast<T>(0.0)) {
+    return static_cast<T>(0.0);
+  }
+  // Handle the undefined parameters of the probability density function
+  if (std::isnan(EvaluateAtAbscissa(static_cast<T>(0.0), N, K, n))) {
+    return NAN;
+  }
+  double k = std::floor(x);
+  double lowerBound = std::max(0.0, static_cast<double>(n + K - N));
+  double upperBound = std::min(n, K);
+  if (k < lowerBound) {
+    return static_cast<T>(0.0);
+  }
+  if (k >= upperBound) {
+    return static_cast<T>(1.0);
+  }
+  /* The probabilities decrease on both sides of the mode. The tail on the
+   * side of k that does not contain the mode is summed, from k, until its
+   * terms become negligible. Successive terms are computed with the ratio
+   * P(i+1)/P(i) = (K-i)(n-i)/((i+1)(N-K-n+i+1)). */
+  double mode = std::floor((n + 1.0) * (K + 1.0) / (N + 2.0));
+  bool sumLowerTail = k < mode;
+  double i = sumLowerTail ? k : k + 1.0;
+  double term = std::exp(
+      LogBinomialCoefficient(i, K) + LogBinomialCoefficient(n - i, N - K) -
+      LogBinomialCoefficient(n, N));
+  double sum = 0.0;
+  while (term > sum * DBL_EPSILON) {
+    sum += term;
+    if (sumLowerTail) {
+      if (i <= lowerBound) {
+        break;
+      }
+      term *= i * (N - K - n + i) / ((K - i + 1.0) * (n - i + 1.0));
+      i--;
+    } else {
+      if (i >= upperBound) {
+        break;
+      }
+      term *= (K - i) * (n - i) / ((i + 1.0) * (N - K - n + i + 1.0));
+      i++;
+    }
+  }
+  return sumLowerTail ? sum : 1.0 - sum;
+}
+
 template <typename T>
 T HypergeometricDistribution::CumulativeDistributiveInverseForProbability(
     T probability, T N, T K, T n) {
@@ -51,16 +107,24 @@ T HypergeometricDistribution::CumulativeDistributiveInverseForProbability(
   }
   T proba = probability;
   const void *pack[3] = {&N, &K, &n};
-  return SolverAlgorithms::CumulativeDistributiveInverseForNDefinedFunction<T>(
-      &proba,
-      [](T x, const void *auxiliary) {
-        const void *const *pack = static_cast<const void *const *>(auxiliary);
-        T N = *static_cast<const T *>(pack[0]);
-        T K = *static_cast<const T *>(pack[1]);
-        T n = *static_cast<const T *>(pack[2]);
-        return HypergeometricDistribution::EvaluateAtAbscissa(x, N, K, n);
-      },
-      pack);
+  return SolverAlgorithms::
+      CumulativeDistributiveInverseForNDefinedCumulativeFunction<T>(
+          &proba,
+          [](T x, const void *auxiliary) {
+            const void *const *pack =
+                static_cast<const void *const *>(auxiliary);
+            T N = *static_cast<const T *>(pack[0]);
+            T K = *static_cast<const T *>(pack[1]);
+            T n = *static_cast<const T *>(pack[2]);
+            return HypergeometricDistribution::
+                CumulativeDistributiveFunctionAtAbscissa(x, N, K, n);
+          },
+          pack);
+}
+
+double HypergeometricDistribution::LogBinomialCoefficient(double k, double n) {
+  return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) -
+         std::lgamma(n - k + 1.0);
 }
 
 template <typename T>
@@ -105,6 +169,12 @@ template double HypergeometricDistribution::EvaluateAtAbscissa<double>(double,
                                                                        double,
                                                                        double);
 template float
+HypergeometricDistribution::CumulativeDistributiveFunctionAtAbscissa<float>(
+    float, float, float, float);
+template double
+HypergeometricDistribution::CumulativeDistributiveFunctionAtAbscissa<double>(
+    double, double, double, double);
+template float
 HypergeometricDistribution::CumulativeDistributiveInverseForProbability<float>(
     float, float, float, float);
 template double
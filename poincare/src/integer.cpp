@@ -175,44 +175,105 @@ int Integer::serialize(char *buffer, int bufferSize, OMG::Base base) const {
   }
 }
 
-int Integer::serializeInDecimal(char *buffer, int bufferSize) const {
-  Integer base(10);
-  Integer abs = *this;
-  abs.setNegative(false);
-  IntegerDivision d = udiv(abs, base);
-
-  int length = 0;
-  if (isZero()) {
-    length += SerializationHelper::CodePoint(buffer + length,
-                                             bufferSize - length, '0');
-  } else if (isNegative()) {
-    length += SerializationHelper::CodePoint(buffer + length,
-                                             bufferSize - length, '-');
-  }
-
-  while (!(d.remainder.isZero() && d.quotient.isZero())) {
-    char c = OMG::Print::CharacterForDigit(
-        OMG::Base::Decimal, d.remainder.isZero() ? 0 : d.remainder.digit(0));
-    if (length >= bufferSize - 1) {
-      return PrintFloat::ConvertFloatToText<float>(
-                 NAN, buffer, bufferSize, PrintFloat::k_maxFloatGlyphLength,
-                 PrintFloat::k_numberOfStoredSignificantDigits,
-                 Preferences::PrintFloatMode::Decimal)
-          .CharLength;
+/* Decimal conversions work on chunks of 9 decimal digits, 10^9 being the
+ * largest power of 10 that fits in a native_uint_t. Each pass over the digits
+ * divides them by 10^9 instead of 10, and no Integer is built in the pool. */
+constexpr static int k_decimalChunkLength = 9;
+constexpr static native_uint_t k_decimalChunk = 1000000000;
+// log(2^32)/log(10^9) < 15/14
+constexpr static int k_maxNumberOfDecimalChunks =
+    Integer::k_maxNumberOfDigits * 15 / 14 + 1;
+
+/* The chunks of the last converted integer are kept: the number of base 10
+ * digits of an integer is often required right before it is serialized, by
+ * Decimal for instance, and both only need one conversion. */
+struct DecimalChunks {
+  native_uint_t digits[Integer::k_maxNumberOfDigits];
+  native_uint_t chunks[k_maxNumberOfDecimalChunks];  // Little-endian
+  uint8_t numberOfDigits;
+  uint8_t numberOfChunks;
+};
+static DecimalChunks s_lastDecimalChunks = {{}, {}, 0, 0};
+
+static const DecimalChunks *DecimalChunksOf(const native_uint_t *digits,
+                                            int numberOfDigits) {
+  assert(numberOfDigits <= Integer::k_maxNumberOfDigits);
+  DecimalChunks *c = &s_lastDecimalChunks;
+  size_t digitsSize = numberOfDigits * sizeof(native_uint_t);
+  if (c->numberOfDigits == numberOfDigits &&
+      memcmp(c->digits, digits, digitsSize) == 0) {
+    return c;
+  }
+  memcpy(c->digits, digits, digitsSize);
+  c->numberOfDigits = numberOfDigits;
+  c->numberOfChunks = 0;
+  // Successive divisions by 10^9 are made in place in the working buffer
+  memcpy(s_workingBuffer, digits, digitsSize);
+  int n = numberOfDigits;
+  while (n > 0) {
+    double_native_uint_t remainder = 0;
+    for (int i = n - 1; i >= 0; i--) {
+      remainder = (remainder << (8 * sizeof(native_uint_t))) |
+                  static_cast<double_native_uint_t>(s_workingBuffer[i]);
+      s_workingBuffer[i] =
+          static_cast<native_uint_t>(remainder / k_decimalChunk);
+      remainder %= k_decimalChunk;
+    }
+    assert(c->numberOfChunks < k_maxNumberOfDecimalChunks);
+    c->chunks[c->numberOfChunks++] = static_cast<native_uint_t>(remainder);
+    while (n > 0 && s_workingBuffer[n - 1] == 0) {
+      n--;
     }
-    length +=
-        SerializationHelper::CodePoint(buffer + length, bufferSize - length, c);
-    d = udiv(d.quotient, base);
   }
-  assert(length <= bufferSize - 1);
-  buffer[length] = 0;
+  return c;
+}
+
+static int NumberOfBase10DigitsInChunk(native_uint_t chunk) {
+  int length = 1;
+  while (chunk >= 10) {
+    chunk /= 10;
+    length++;
+  }
+  return length;
+}
 
-  // Flip the string
-  for (int i = m_negative, j = length - 1; i < j; i++, j--) {
-    char c = buffer[i];
-    buffer[i] = buffer[j];
-    buffer[j] = c;
+static int NumberOfBase10Digits(const DecimalChunks *c) {
+  if (c->numberOfChunks == 0) {
+    return 1;
+  }
+  return k_decimalChunkLength * (c->numberOfChunks - 1) +
+         NumberOfBase10DigitsInChunk(c->chunks[c->numberOfChunks - 1]);
+}
+
+int Integer::serializeInDecimal(char *buffer, int bufferSize) const {
+  const DecimalChunks *c = DecimalChunksOf(digits(), numberOfDigits());
+  int length = m_negative + NumberOfBase10Digits(c);
+  if (length >= bufferSize) {
+    return PrintFloat::ConvertFloatToText<float>(
+               NAN, buffer, bufferSize, PrintFloat::k_maxFloatGlyphLength,
+               PrintFloat::k_numberOfStoredSignificantDigits,
+               Preferences::PrintFloatMode::Decimal)
+        .CharLength;
+  }
+  if (m_negative) {
+    buffer[0] = '-';
+  }
+  buffer[length] = 0;
+  // Fill the buffer backwards, from the least significant chunk
+  int position = length;
+  for (int i = 0; i < c->numberOfChunks; i++) {
+    native_uint_t chunk = c->chunks[i];
+    bool isLast = i == c->numberOfChunks - 1;
+    for (int j = 0; j < k_decimalChunkLength && !(isLast && chunk == 0); j++) {
+      buffer[--position] =
+          OMG::Print::CharacterForDigit(OMG::Base::Decimal, chunk % 10);
+      chunk /= 10;
+    }
   }
+  if (c->numberOfChunks == 0) {
+    buffer[--position] = '0';
+  }
+  assert(position == m_negative);
   return length;
 }
 
@@ -356,16 +417,8 @@ T Integer::approximate() const {
 // Properties
 
 int Integer::NumberOfBase10DigitsWithoutSign(const Integer &i) {
-  // TODO: This method should be optimized because udiv is a costly function
   assert(!i.isOverflow());
-  int numberOfDigits = 1;
-  Integer base(10);
-  IntegerDivision d = udiv(i, base);
-  while (!d.quotient.isZero()) {
-    d = udiv(d.quotient, base);
-    numberOfDigits++;
-  }
-  return numberOfDigits;
+  return NumberOfBase10Digits(DecimalChunksOf(i.digits(), i.numberOfDigits()));
 }
 
 // Comparison
@@ -494,55 +547,164 @@ Integer Integer::addition(const Integer &a, const Integer &b,
   }
 }
 
+/* Operations on little-endian arrays of digits, used by the multiplication.
+ * Products are written on na+nb digits, and the operands of a Karatsuba
+ * multiplication have at most k_maxNumberOfDigits+1 digits. */
+
+constexpr static int k_maxNumberOfOperandDigits =
+    Integer::k_maxNumberOfDigits + 1;
+
+/* The schoolbook multiplication is faster below this number of digits, as
+ * measured on the simulator. The product of two such operands has at least
+ * 2 * POINCARE_INTEGER_KARATSUBA_THRESHOLD - 1 digits: it overflows the
+ * default k_maxNumberOfDigits, and Karatsuba is only built when
+ * POINCARE_INTEGER_MAX_NUMBER_OF_DIGITS is raised. */
+#define POINCARE_INTEGER_KARATSUBA_THRESHOLD 24
+#define POINCARE_INTEGER_KARATSUBA                 \
+  (2 * POINCARE_INTEGER_KARATSUBA_THRESHOLD - 1 <= \
+   POINCARE_INTEGER_MAX_NUMBER_OF_DIGITS + 1)
+
+// Schoolbook multiplication: result = a*b
+static void MultiplyDigits(const native_uint_t *a, int na,
+                           const native_uint_t *b, int nb,
+                           native_uint_t *result) {
+  memset(result, 0, (na + nb) * sizeof(native_uint_t));
+  for (int i = 0; i < na; i++) {
+    double_native_uint_t aDigit = a[i];
+    double_native_uint_t carry = 0;
+    for (int j = 0; j < nb; j++) {
+      /* aDigit*bDigit + result[i+j] + carry < 2^64, since each of the three
+       * terms is at most (2^32-1)^2, 2^32-1 and 2^32-1. */
+      double_native_uint_t p =
+          aDigit * static_cast<double_native_uint_t>(b[j]) + result[i + j] +
+          carry;
+      result[i + j] = static_cast<native_uint_t>(p);
+      carry = p >> (8 * sizeof(native_uint_t));
+    }
+    result[i + nb] = static_cast<native_uint_t>(carry);
+  }
+}
+
+#if POINCARE_INTEGER_KARATSUBA
+
+// a += b, with nb <= na. Returns the carry.
+static native_uint_t AddDigits(native_uint_t *a, int na, const native_uint_t *b,
+                               int nb) {
+  assert(nb <= na);
+  double_native_uint_t carry = 0;
+  int i = 0;
+  for (; i < nb; i++) {
+    carry += static_cast<double_native_uint_t>(a[i]) + b[i];
+    a[i] = static_cast<native_uint_t>(carry);
+    carry >>= 8 * sizeof(native_uint_t);
+  }
+  for (; carry != 0 && i < na; i++) {
+    carry += a[i];
+    a[i] = static_cast<native_uint_t>(carry);
+    carry >>= 8 * sizeof(native_uint_t);
+  }
+  return static_cast<native_uint_t>(carry);
+}
+
+// a -= b, with nb <= na and b <= a
+static void SubtractDigits(native_uint_t *a, int na, const native_uint_t *b,
+                           int nb) {
+  assert(nb <= na);
+  // borrow is 0 or -1, shifted arithmetically
+  double_native_int_t borrow = 0;
+  int i = 0;
+  for (; i < nb; i++) {
+    borrow += static_cast<double_native_int_t>(a[i]) - b[i];
+    a[i] = static_cast<native_uint_t>(borrow);
+    borrow >>= 8 * sizeof(native_uint_t);
+  }
+  for (; borrow != 0 && i < na; i++) {
+    borrow += a[i];
+    a[i] = static_cast<native_uint_t>(borrow);
+    borrow >>= 8 * sizeof(native_uint_t);
+  }
+  assert(borrow == 0);
+}
+
+/* Karatsuba multiplication of two n-digit arrays: result = a*b on 2n digits.
+ * With a = a1*B^m+a0 and b = b1*B^m+b0,
+ * a*b = a1*b1*B^(2m) + ((a0+a1)*(b0+b1)-a0*b0-a1*b1)*B^m + a0*b0
+ * which only takes three multiplications of half the size. */
+constexpr static int k_karatsubaThreshold =
+    POINCARE_INTEGER_KARATSUBA_THRESHOLD;
+
+static void KaratsubaMultiplyDigits(const native_uint_t *a,
+                                    const native_uint_t *b, int n,
+                                    native_uint_t *result) {
+  if (n < k_karatsubaThreshold) {
+    MultiplyDigits(a, n, b, n, result);
+    return;
+  }
+  assert(n <= k_maxNumberOfOperandDigits);
+  int m = n / 2;
+  int h = n - m;
+  // a0*b0 and a1*b1 fill result
+  KaratsubaMultiplyDigits(a, b, m, result);
+  KaratsubaMultiplyDigits(a + m, b + m, h, result + 2 * m);
+  // (a0+a1)*(b0+b1) on 2(h+1) digits
+  native_uint_t aSum[k_maxNumberOfOperandDigits / 2 + 2];
+  native_uint_t bSum[k_maxNumberOfOperandDigits / 2 + 2];
+  memcpy(aSum, a + m, h * sizeof(native_uint_t));
+  memcpy(bSum, b + m, h * sizeof(native_uint_t));
+  aSum[h] = AddDigits(aSum, h, a, m);
+  bSum[h] = AddDigits(bSum, h, b, m);
+  native_uint_t middle[k_maxNumberOfOperandDigits + 3];
+  KaratsubaMultiplyDigits(aSum, bSum, h + 1, middle);
+  SubtractDigits(middle, 2 * (h + 1), result, 2 * m);
+  SubtractDigits(middle, 2 * (h + 1), result + 2 * m, 2 * h);
+  // middle < B^(2h+1) and the product fits in 2n digits
+  AddDigits(result + m, 2 * n - m, middle,
+            std::min(2 * (h + 1), 2 * n - m));
+}
+
+#endif
+
 Integer Integer::multiplication(const Integer &a, const Integer &b,
                                 bool oneDigitOverflow) {
   if (a.isOverflow() || b.isOverflow()) {
     return Integer::Overflow(a.m_negative != b.m_negative);
   }
-
-  // Enable overflowing of 1 digit
-  uint8_t size = std::min(a.numberOfDigits() + b.numberOfDigits(),
-                          k_maxNumberOfDigits + oneDigitOverflow);
-
-  memset(s_workingBuffer, 0, size * sizeof(native_uint_t));
-
-  double_native_uint_t carry = 0;
-  for (uint8_t i = 0; i < a.numberOfDigits(); i++) {
-    double_native_uint_t aDigit = a.digit(i);
-    carry = 0;
-    for (uint8_t j = 0; j < b.numberOfDigits(); j++) {
-      double_native_uint_t bDigit = b.digit(j);
-      /* The fact that aDigit and bDigit are double_native is very important,
-       * otherwise the product might end up being computed on single_native size
-       * and then zero-padded. */
-      // TODO: Prove it cannot overflow double_native type
-      double_native_uint_t p = aDigit * bDigit + carry;
-      native_uint_t *l = (native_uint_t *)&p;
-      if (i + j < (uint8_t)k_maxNumberOfDigits + oneDigitOverflow) {
-        p += s_workingBuffer[i + j];
-        s_workingBuffer[i + j] = l[0];
-      } else {
-        if (l[0] != 0) {
-          // Overflow the largest Integer
-          return Integer::Overflow(a.m_negative != b.m_negative);
-        }
-      }
-      carry = l[1];
-    }
-    if (i + b.numberOfDigits() <
-        (uint8_t)k_maxNumberOfDigits + oneDigitOverflow) {
-      s_workingBuffer[i + b.numberOfDigits()] += carry;
-    } else {
-      if (carry != 0) {
-        // Overflow the largest Integer
-        return Integer::Overflow(a.m_negative != b.m_negative);
-      }
-    }
+  int na = a.numberOfDigits();
+  int nb = b.numberOfDigits();
+  /* a*b >= B^(na-1)*B^(nb-1) has at least na+nb-1 digits, no need to compute
+   * it to know that it overflows. */
+  if (na > 0 && nb > 0 &&
+      na + nb - 1 > k_maxNumberOfDigits + oneDigitOverflow) {
+    return Integer::Overflow(a.m_negative != b.m_negative);
   }
-  while (size > 0 && s_workingBuffer[size - 1] == 0) {
+  const native_uint_t *aDigits = a.digits();
+  const native_uint_t *bDigits = b.digits();
+  native_uint_t product[2 * k_maxNumberOfOperandDigits];
+#if POINCARE_INTEGER_KARATSUBA
+  if (std::min(na, nb) >= k_karatsubaThreshold) {
+    // Pad the shortest operand with zeros
+    int n = std::max(na, nb);
+    native_uint_t padded[k_maxNumberOfOperandDigits];
+    const native_uint_t *shortest = na < nb ? aDigits : bDigits;
+    memset(padded, 0, n * sizeof(native_uint_t));
+    memcpy(padded, shortest, std::min(na, nb) * sizeof(native_uint_t));
+    KaratsubaMultiplyDigits(na < nb ? padded : aDigits,
+                            na < nb ? bDigits : padded, n, product);
+  } else {
+    MultiplyDigits(aDigits, na, bDigits, nb, product);
+  }
+#else
+  MultiplyDigits(aDigits, na, bDigits, nb, product);
+#endif
+  int size = na + nb;
+  while (size > 0 && product[size - 1] == 0) {
     size--;
   }
-  return BuildInteger(s_workingBuffer, size, a.m_negative != b.m_negative,
+  if (size > k_maxNumberOfDigits + oneDigitOverflow) {
+    // Overflow the largest Integer
+    return Integer::Overflow(a.m_negative != b.m_negative);
+  }
+  return BuildInteger(product, size, a.m_negative != b.m_negative,
                       oneDigitOverflow);
 }
 
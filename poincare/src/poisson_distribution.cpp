@@ -4,7 +4,7 @@
 #include <poincare/domain.h>
 #include <poincare/float.h>
 #include <poincare/poisson_distribution.h>
-#include <poincare/regularized_incomplete_beta_function.h>
+#include <poincare/regularized_gamma_function.h>
 #include <poincare/solver.h>
 
 #include <cmath>
@@ -24,6 +24,37 @@ T PoissonDistribution::EvaluateAtAbscissa(T x, T lambda) {
   return std::exp(lResult);
 }
 
+template <typename T>
+T PoissonDistribution::CumulativeDistributiveFunctionAtAbscissa(T x, T lambda) {
+  if (!LambdaIsOK(lambda) || std::isnan(x)) {
+    return NAN;
+  }
+  if (std::isinf(x)) {
+    return x > static_cast<T>(0.0) ? static_cast<T>(1.0) : static_cast<T>(0.0);
+  }
+  if (x < static_cast<T>(0.0)) {
+    return static_cast<T>(0.0);
+  }
+  // P(X <= k) = Q(k+1, lambda) with Q the upper regularized gamma function
+  double result;
+  if (RegularizedUpperGammaFunction(std::floor(x) + 1.0, lambda,
+                                    k_regularizedGammaPrecision,
+                                    k_maxNumberOfRegularizedGammaIterations,
+                                    &result)) {
+    return result;
+  }
+  // Sum the probabilities if the regularized gamma function did not converge
+  const void *pack[1] = {&lambda};
+  return SolverAlgorithms::CumulativeDistributiveFunctionForNDefinedFunction<T>(
+      x,
+      [](T k, const void *auxiliary) {
+        const void *const *pack = static_cast<const void *const *>(auxiliary);
+        T lambda = *static_cast<const T *>(pack[0]);
+        return PoissonDistribution::EvaluateAtAbscissa(k, lambda);
+      },
+      pack);
+}
+
 template <typename T>
 T PoissonDistribution::CumulativeDistributiveInverseForProbability(
     T probability, T lambda) {
@@ -41,14 +72,17 @@ T PoissonDistribution::CumulativeDistributiveInverseForProbability(
   }
   T proba = probability;
   const void *pack[1] = {&lambda};
-  return SolverAlgorithms::CumulativeDistributiveInverseForNDefinedFunction<T>(
-      &proba,
-      [](T x, const void *auxiliary) {
-        const void *const *pack = static_cast<const void *const *>(auxiliary);
-        T lambda = *static_cast<const T *>(pack[0]);
-        return PoissonDistribution::EvaluateAtAbscissa(x, lambda);
-      },
-      pack);
+  return SolverAlgorithms::
+      CumulativeDistributiveInverseForNDefinedCumulativeFunction<T>(
+          &proba,
+          [](T x, const void *auxiliary) {
+            const void *const *pack =
+                static_cast<const void *const *>(auxiliary);
+            T lambda = *static_cast<const T *>(pack[0]);
+            return PoissonDistribution::
+                CumulativeDistributiveFunctionAtAbscissa(x, lambda);
+          },
+          pack);
 }
 
 template <typename T>
@@ -66,6 +100,12 @@ bool PoissonDistribution::ExpressionLambdaIsOK(bool *result,
 template float PoissonDistribution::EvaluateAtAbscissa<float>(float, float);
 template double PoissonDistribution::EvaluateAtAbscissa<double>(double, double);
 template float
+PoissonDistribution::CumulativeDistributiveFunctionAtAbscissa<float>(float,
+                                                                     float);
+template double
+PoissonDistribution::CumulativeDistributiveFunctionAtAbscissa<double>(double,
+                                                                      double);
+template float
 PoissonDistribution::CumulativeDistributiveInverseForProbability<float>(float,
                                                                         float);
 template double
@@ -89,17 +89,22 @@ bool InfiniteSeriesEvaluation(double firstTerm, TermUpdater termUpdater,
   return true;
 }
 
-double RegularizedGammaFunction(double s, double x, double epsilon,
-                                int maxNumberOfIterations, double* result) {
+/* Compute the lower regularized gamma function P(s,x), or the upper one
+ * Q(s,x) = 1 - P(s,x) if upper is true. Each representation computes one of
+ * them directly, so that the other is only deduced from it when it is not
+ * small. */
+static bool PrivateRegularizedGammaFunction(double s, double x, double epsilon,
+                                            int maxNumberOfIterations,
+                                            double* result, bool upper) {
   // TODO Put interruption instead of maxNumberOfIterations
 
   assert(!std::isnan(s) && !std::isnan(x) && s > 0.0 && x >= 0.0);
   if (x == 0.0) {
-    *result = 0.0;
+    *result = upper ? 1.0 : 0.0;
     return true;
   }
   if (std::isinf(x)) {
-    *result = 1.0;
+    *result = upper ? 0.0 : 1.0;
     return true;
   }
   if (x >= s + 1.0) {
@@ -143,8 +148,9 @@ double RegularizedGammaFunction(double s, double x, double epsilon,
             maxNumberOfIterations, &continuedFractionValue, s, x)) {
       return false;
     }
-    *result = 1.0 - std::exp(-x + s * std::log(x) - std::lgamma(s)) *
-                        (1.0 / continuedFractionValue);
+    double upperResult = std::exp(-x + s * std::log(x) - std::lgamma(s)) *
+                         (1.0 / continuedFractionValue);
+    *result = upper ? upperResult : 1.0 - upperResult;
     return true;
   }
 
@@ -160,11 +166,25 @@ double RegularizedGammaFunction(double s, double x, double epsilon,
           0.0)) {
     return false;
   }
-  *result = std::isinf(infiniteSeriesValue)
-                ? 1.0
-                : std::exp(-x + s * std::log(x) - std::lgamma(s)) *
-                      infiniteSeriesValue;
+  double lowerResult = std::isinf(infiniteSeriesValue)
+                           ? 1.0
+                           : std::exp(-x + s * std::log(x) - std::lgamma(s)) *
+                                 infiniteSeriesValue;
+  *result = upper ? 1.0 - lowerResult : lowerResult;
   return true;
 }
 
+double RegularizedGammaFunction(double s, double x, double epsilon,
+                                int maxNumberOfIterations, double* result) {
+  return PrivateRegularizedGammaFunction(s, x, epsilon, maxNumberOfIterations,
+                                         result, false);
+}
+
+double RegularizedUpperGammaFunction(double s, double x, double epsilon,
+                                     int maxNumberOfIterations,
+                                     double* result) {
+  return PrivateRegularizedGammaFunction(s, x, epsilon, maxNumberOfIterations,
+                                         result, true);
+}
+
 }  // namespace Poincare
@@ -54,8 +54,10 @@ double RegularizedIncompleteBetaFunction(double a, double b, double x) {
   double f = 1.0, c = 1.0, d = 0.0;
 
   // TODO Use Helper::ContinuedFractionEvaluation
+  /* The number of iterations grows like sqrt(a + b): the binomial cumulative
+   * function needs about 250 of them for n = 1e5 and 2000 for n = 1e8. */
   int i, m;
-  for (i = 0; i <= 200; ++i) {
+  for (i = 0; i <= 10000; ++i) {
     m = i / 2;
 
     double numerator;
@@ -91,6 +91,55 @@ T SolverAlgorithms::CumulativeDistributiveInverseForNDefinedFunction(
   return result;
 }
 
+template <typename T>
+T SolverAlgorithms::CumulativeDistributiveInverseForNDefinedCumulativeFunction(
+    T* probability, typename Solver<T>::FunctionEvaluation cumulative,
+    const void* aux) {
+  constexpr T precision = Float<T>::Epsilon();
+  assert(*probability <= (static_cast<T>(1.f) - precision) &&
+         *probability >= precision);
+
+  /* Look for the smallest k such that cumulative(k) reaches the probability.
+   * Like the summation, accept a cumulative within sqrt(precision) of the
+   * probability or above k_maxProbability. */
+  T target = std::min(*probability - std::sqrt(precision),
+                      static_cast<T>(k_maxProbability));
+  T value = cumulative(0, aux);
+  if (std::isnan(value)) {
+    return NAN;
+  }
+  // cumulative(lower) < target <= cumulative(upper)
+  int lower = -1;
+  int upper = 0;
+  while (value < target) {
+    if (upper >= k_maxCumulativeInverse) {
+      *probability = static_cast<T>(1.f);
+      return INFINITY;
+    }
+    lower = upper;
+    upper = std::min(2 * upper + 1, k_maxCumulativeInverse);
+    value = cumulative(upper, aux);
+    if (std::isnan(value)) {
+      return NAN;
+    }
+  }
+  while (upper - lower > 1) {
+    int middle = lower + (upper - lower) / 2;
+    T middleValue = cumulative(middle, aux);
+    if (std::isnan(middleValue)) {
+      return NAN;
+    }
+    if (middleValue < target) {
+      lower = middle;
+    } else {
+      upper = middle;
+      value = middleValue;
+    }
+  }
+  *probability = value >= k_maxProbability ? static_cast<T>(1.f) : value;
+  return upper;
+}
+
 template <typename T>
 T SolverAlgorithms::CumulativeDistributiveFunctionForNDefinedFunction(
     T x, typename Solver<T>::FunctionEvaluation f, const void* aux) {
@@ -309,6 +358,14 @@ template double
 SolverAlgorithms::CumulativeDistributiveInverseForNDefinedFunction(
     double* probability, Solver<double>::FunctionEvaluation f, const void* aux);
 template float
+SolverAlgorithms::CumulativeDistributiveInverseForNDefinedCumulativeFunction(
+    float* probability, Solver<float>::FunctionEvaluation cumulative,
+    const void* aux);
+template double
+SolverAlgorithms::CumulativeDistributiveInverseForNDefinedCumulativeFunction(
+    double* probability, Solver<double>::FunctionEvaluation cumulative,
+    const void* aux);
+template float
 SolverAlgorithms::CumulativeDistributiveFunctionForNDefinedFunction(
     float x, Solver<float>::FunctionEvaluation f, const void* aux);
 template double
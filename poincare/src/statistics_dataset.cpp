@@ -56,34 +56,78 @@ T StatisticsDataset<T>::weightAtIndex(int index) const {
 }
 
 template <typename T>
-T StatisticsDataset<T>::totalWeight() const {
-  if (std::isnan(m_memoizedTotalWeight)) {
-    m_memoizedTotalWeight = privateTotalWeight();
+const typename StatisticsDataset<T>::Moments &StatisticsDataset<T>::moments()
+    const {
+  if (m_recomputeMoments) {
+    m_memoizedMoments = computeMoments();
+    m_recomputeMoments = false;
   } else {
-    assert(m_memoizedTotalWeight == privateTotalWeight());
+    assert(m_memoizedMoments.totalWeight == computeMoments().totalWeight ||
+           std::isnan(m_memoizedMoments.totalWeight));
   }
-  return m_memoizedTotalWeight;
+  return m_memoizedMoments;
 }
 
+/* Neumaier's variant of the Kahan summation: the rounding error of each
+ * addition is accumulated in compensation and added back to the sum at the
+ * end. */
 template <typename T>
-T StatisticsDataset<T>::privateTotalWeight() const {
-  if (datasetLength() == 0) {
-    return NAN;
-  }
-  T total = 0.0;
-  for (int i = 0; i < datasetLength(); i++) {
-    total += weightAtIndex(i);
+static void CompensatedAdd(T value, T *sum, T *compensation) {
+  T newSum = *sum + value;
+  if (std::fabs(*sum) >= std::fabs(value)) {
+    *compensation += (*sum - newSum) + value;
+  } else {
+    *compensation += (value - newSum) + *sum;
   }
-  return total;
+  *sum = newSum;
 }
 
 template <typename T>
-T StatisticsDataset<T>::weightedSum() const {
-  T total = 0.0;
-  for (int i = 0; i < datasetLength(); i++) {
-    total += valueAtIndex(i) * weightAtIndex(i);
+static T CompensatedSum(T sum, T compensation) {
+  // The compensation is undefined once the sum overflows
+  return std::isfinite(sum) ? sum + compensation : sum;
+}
+
+template <typename T>
+typename StatisticsDataset<T>::Moments StatisticsDataset<T>::computeMoments()
+    const {
+  int length = datasetLength();
+  if (length == 0) {
+    return {NAN, 0.0, 0.0, NAN};
   }
-  return total;
+  T totalWeight = 0.0, totalWeightCompensation = 0.0;
+  T weightedSum = 0.0, weightedSumCompensation = 0.0;
+  T squaredSum = 0.0, squaredSumCompensation = 0.0;
+  /* The squared deviations from the mean are accumulated with West's weighted
+   * version of Welford's algorithm. It updates the mean and the sum of the
+   * squared deviations at each value, which ensures a positive result and
+   * avoids the cancellation of E[X^2] - E[X]^2. */
+  T runningWeight = 0.0;
+  T runningMean = 0.0;
+  T squaredDeviationSum = 0.0;
+  for (int i = 0; i < length; i++) {
+    T value = valueAtIndex(i);
+    T weight = weightAtIndex(i);
+    if (std::isnan(weight)) {
+      return {NAN, NAN, NAN, NAN};
+    }
+    if (weight == static_cast<T>(0.0)) {
+      continue;
+    }
+    CompensatedAdd(weight, &totalWeight, &totalWeightCompensation);
+    CompensatedAdd(value * weight, &weightedSum, &weightedSumCompensation);
+    CompensatedAdd(value * value * weight, &squaredSum,
+                   &squaredSumCompensation);
+    runningWeight += weight;
+    T deviation = value - runningMean;
+    T meanIncrement = deviation * weight / runningWeight;
+    runningMean += meanIncrement;
+    squaredDeviationSum += (runningWeight - weight) * deviation * meanIncrement;
+  }
+  return {CompensatedSum(totalWeight, totalWeightCompensation),
+          CompensatedSum(weightedSum, weightedSumCompensation),
+          CompensatedSum(squaredSum, squaredSumCompensation),
+          squaredDeviationSum};
 }
 
 template <typename T>
@@ -109,9 +153,8 @@ template <typename T>
 T StatisticsDataset<T>::variance() const {
   /* We use the Var(X) = E[(X-E[X])^2] definition instead of Var(X) = E[X^2] -
    * E[X]^2 to ensure a positive result and to minimize rounding errors */
-  T m = mean();
-  T v = offsettedSquaredSum(m) / totalWeight();
-  return std::abs(v / m) < Float<double>::EpsilonLax() ? 0.0 : v;
+  T v = moments().squaredDeviationSum / totalWeight();
+  return std::abs(v / mean()) < Float<double>::EpsilonLax() ? 0.0 : v;
 }
 
 template <typename T>
@@ -131,59 +174,285 @@ T StatisticsDataset<T>::sortedElementAtCumulatedFrequency(
 template <typename T>
 T StatisticsDataset<T>::sortedElementAtCumulatedWeight(
     T weight, bool createMiddleElement) const {
-  int upperIndex;
-  int lowerIndex = indexAtCumulatedWeight(weight, &upperIndex);
-  if (lowerIndex < 0) {
-    return NAN;
-  }
-  if (createMiddleElement && upperIndex != lowerIndex) {
-    return (valueAtIndex(lowerIndex) + valueAtIndex(upperIndex)) / 2.0;
-  }
-  return valueAtIndex(lowerIndex);
+  T result;
+  sortedElementsAtCumulatedWeights(&weight, 1, createMiddleElement, &result);
+  return result;
 }
 
 template <typename T>
 int StatisticsDataset<T>::indexAtCumulatedWeight(T weight,
                                                  int *upperIndex) const {
-  if (std::isnan(weight)) {
-    if (upperIndex) {
-      *upperIndex = -1;
+  int lowerIndex, upper;
+  indexesAtCumulatedWeights(&weight, 1, &lowerIndex, &upper);
+  if (upperIndex) {
+    *upperIndex = upper;
+  }
+  return lowerIndex;
+}
+
+template <typename T>
+void StatisticsDataset<T>::sortedElementsAtCumulatedFrequencies(
+    const T *frequencies, int numberOfFrequencies, bool createMiddleElement,
+    T *results) const {
+  assert(numberOfFrequencies <= k_maxNumberOfCumulatedWeights);
+  T weights[k_maxNumberOfCumulatedWeights];
+  T total = totalWeight();
+  for (int i = 0; i < numberOfFrequencies; i++) {
+    assert(frequencies[i] >= 0.0 && frequencies[i] <= 1.0);
+    weights[i] = frequencies[i] * total;
+  }
+  sortedElementsAtCumulatedWeights(weights, numberOfFrequencies,
+                                   createMiddleElement, results);
+}
+
+template <typename T>
+void StatisticsDataset<T>::sortedElementsAtCumulatedWeights(
+    const T *weights, int numberOfWeights, bool createMiddleElement,
+    T *results) const {
+  assert(numberOfWeights <= k_maxNumberOfCumulatedWeights);
+  int lowerIndexes[k_maxNumberOfCumulatedWeights];
+  int upperIndexes[k_maxNumberOfCumulatedWeights];
+  indexesAtCumulatedWeights(weights, numberOfWeights, lowerIndexes,
+                            upperIndexes);
+  for (int i = 0; i < numberOfWeights; i++) {
+    if (lowerIndexes[i] < 0) {
+      results[i] = NAN;
+    } else if (createMiddleElement && upperIndexes[i] != lowerIndexes[i]) {
+      results[i] =
+          (valueAtIndex(lowerIndexes[i]) + valueAtIndex(upperIndexes[i])) /
+          2.0;
+    } else {
+      results[i] = valueAtIndex(lowerIndexes[i]);
+    }
+  }
+}
+
+template <typename T>
+void StatisticsDataset<T>::indexesAtCumulatedWeights(const T *weights,
+                                                     int numberOfWeights,
+                                                     int *lowerIndexes,
+                                                     int *upperIndexes) const {
+  assert(numberOfWeights <= k_maxNumberOfCumulatedWeights);
+  bool canSelect = !m_isMemoized && m_recomputeSortedIndex &&
+                   !m_hasSelectedElements && datasetLength() > 0 &&
+                   !std::isnan(totalWeight());
+  for (int i = 0; i < numberOfWeights; i++) {
+    // NaN weights are not ordered
+    assert(i == 0 || !(weights[i] < weights[i - 1]));
+    canSelect = canSelect && !std::isnan(weights[i]);
+  }
+  if (canSelect) {
+    m_hasSelectedElements = true;
+    if (selectIndexesAtCumulatedWeights(weights, numberOfWeights, lowerIndexes,
+                                        upperIndexes)) {
+      return;
     }
-    return -1;
   }
+  indexesAtCumulatedWeightsInSortedIndex(weights, numberOfWeights,
+                                         lowerIndexes, upperIndexes);
+}
+
+template <typename T>
+void StatisticsDataset<T>::indexesAtCumulatedWeightsInSortedIndex(
+    const T *weights, int numberOfWeights, int *lowerIndexes,
+    int *upperIndexes) const {
   T epsilon = sizeof(T) == sizeof(double) ? DBL_EPSILON : FLT_EPSILON;
-  int elementSortedIndex = -1;
-  T cumulatedWeight = 0.0;
-  for (int i = 0; i < datasetLength(); i++) {
-    elementSortedIndex = i;
-    T elementWeight = weightAtIndex(indexAtSortedIndex(i));
-    if (elementWeight == static_cast<T>(0.0)) {
+  for (int w = 0; w < numberOfWeights; w++) {
+    T weight = weights[w];
+    if (std::isnan(weight)) {
+      lowerIndexes[w] = upperIndexes[w] = -1;
       continue;
     }
-    cumulatedWeight += elementWeight;
-    if (cumulatedWeight >= weight - epsilon) {
-      break;
+    int elementSortedIndex = -1;
+    T cumulatedWeight = 0.0;
+    for (int i = 0; i < datasetLength(); i++) {
+      elementSortedIndex = i;
+      T elementWeight = weightAtIndex(indexAtSortedIndex(i));
+      if (elementWeight == static_cast<T>(0.0)) {
+        continue;
+      }
+      cumulatedWeight += elementWeight;
+      if (cumulatedWeight >= weight - epsilon) {
+        break;
+      }
     }
-  }
-  if (std::fabs(cumulatedWeight - weight) < epsilon) {
-    /* There is an element of cumulated weight, so the result is
-     * the mean between this element and the next element (in terms of cumulated
-     * weight) that has a non-null weight. */
-    for (int i = elementSortedIndex + 1; i < datasetLength(); i++) {
-      int nextElementIndex = indexAtSortedIndex(i);
-      T nextWeight = weightAtIndex(nextElementIndex);
-      if (!std::isnan(nextWeight) && nextWeight > 0.0) {
-        if (upperIndex) {
-          *upperIndex = nextElementIndex;
+    lowerIndexes[w] = upperIndexes[w] = indexAtSortedIndex(elementSortedIndex);
+    if (std::fabs(cumulatedWeight - weight) < epsilon) {
+      /* There is an element of cumulated weight, so the result is
+       * the mean between this element and the next element (in terms of
+       * cumulated weight) that has a non-null weight. */
+      for (int i = elementSortedIndex + 1; i < datasetLength(); i++) {
+        int nextElementIndex = indexAtSortedIndex(i);
+        T nextWeight = weightAtIndex(nextElementIndex);
+        if (!std::isnan(nextWeight) && nextWeight > 0.0) {
+          upperIndexes[w] = nextElementIndex;
+          break;
         }
-        return indexAtSortedIndex(elementSortedIndex);
       }
     }
   }
-  if (upperIndex) {
-    *upperIndex = indexAtSortedIndex(elementSortedIndex);
+}
+
+/* The elements at cumulated weights are found with a weighted quickselect on a
+ * permutation of the indexes: once partitioned around a pivot, the weight of
+ * each part tells which part contains each requested element, so that only
+ * those parts are partitioned further. All the elements are positive and
+ * non-NaN, as they are only selected when the total weight is defined. */
+template <typename T>
+bool StatisticsDataset<T>::selectIndexesAtCumulatedWeights(
+    const T *weights, int numberOfWeights, int *lowerIndexes,
+    int *upperIndexes) const {
+  int length = datasetLength();
+  FloatList<float> permutation = FloatList<float>::Builder();
+  for (int i = 0; i < length; i++) {
+    permutation.addValueAtIndex(static_cast<float>(i), i);
+  }
+  /* Give up on pivots making the selection quadratic and sort the dataset
+   * instead, as IntroSort does. */
+  int maxDepth = 0;
+  for (int n = length; n > 1; n /= 2) {
+    maxDepth += 2;
+  }
+  int positions[k_maxNumberOfCumulatedWeights];
+  T cumulatedWeights[k_maxNumberOfCumulatedWeights];
+  if (!selectPositionsAtCumulatedWeights(&permutation, 0, length, 0.0, weights,
+                                         numberOfWeights, positions,
+                                         cumulatedWeights, maxDepth)) {
+    return false;
+  }
+  T epsilon = sizeof(T) == sizeof(double) ? DBL_EPSILON : FLT_EPSILON;
+  for (int w = 0; w < numberOfWeights; w++) {
+    int lowerIndex = static_cast<int>(permutation.valueAtIndex(positions[w]));
+    lowerIndexes[w] = upperIndexes[w] = lowerIndex;
+    if (std::fabs(cumulatedWeights[w] - weights[w]) >= epsilon) {
+      continue;
+    }
+    /* The next element in terms of cumulated weight is the smallest one with
+     * a non-null weight placed after the lower element by the selection. */
+    for (int i = positions[w] + 1; i < length; i++) {
+      int index = static_cast<int>(permutation.valueAtIndex(i));
+      if (weightAtIndex(index) > 0.0 &&
+          (upperIndexes[w] == lowerIndex ||
+           m_values->valueAtIndex(index) <
+               m_values->valueAtIndex(upperIndexes[w]))) {
+        upperIndexes[w] = index;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool StatisticsDataset<T>::selectPositionsAtCumulatedWeights(
+    FloatList<float> *permutation, int start, int end, T weightBefore,
+    const T *weights, int numberOfWeights, int *positions, T *cumulatedWeights,
+    int maxDepth) const {
+  constexpr int k_maxLengthForInsertionSort = 16;
+  if (numberOfWeights == 0) {
+    return true;
+  }
+  auto swap = [permutation](int i, int j) {
+    float temp = permutation->valueAtIndex(i);
+    permutation->replaceValueAtIndex(permutation->valueAtIndex(j), i);
+    permutation->replaceValueAtIndex(temp, j);
+  };
+  auto value = [this, permutation](int i) {
+    return m_values->valueAtIndex(
+        static_cast<int>(permutation->valueAtIndex(i)));
+  };
+  if (end - start <= k_maxLengthForInsertionSort) {
+    for (int i = start + 1; i < end; i++) {
+      for (int j = i; j > start && value(j - 1) > value(j); j--) {
+        swap(j - 1, j);
+      }
+    }
+    positionsAtCumulatedWeightsInRange(permutation, start, end, weightBefore,
+                                       weights, numberOfWeights, positions,
+                                       cumulatedWeights);
+    return true;
+  }
+  if (maxDepth == 0) {
+    return false;
+  }
+  // Median of the first, middle and last values
+  T a = value(start), b = value(start + (end - start) / 2), c = value(end - 1);
+  T pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+  /* Three-way partition into [start, lessEnd) < pivot,
+   * [lessEnd, greaterStart) = pivot and [greaterStart, end) > pivot. */
+  int lessEnd = start, greaterStart = end;
+  T lessWeight = 0.0, equalWeight = 0.0;
+  for (int i = start; i < greaterStart;) {
+    T v = value(i);
+    if (v < pivot) {
+      lessWeight +=
+          weightAtIndex(static_cast<int>(permutation->valueAtIndex(i)));
+      swap(lessEnd++, i++);
+    } else if (v > pivot) {
+      swap(i, --greaterStart);
+    } else {
+      equalWeight +=
+          weightAtIndex(static_cast<int>(permutation->valueAtIndex(i)));
+      i++;
+    }
+  }
+  /* The first element reaching a weight is looked for in the part where the
+   * cumulated weight reaches it. Weights beyond the total weight give the last
+   * element, so they are looked for in the last part. */
+  T epsilon = sizeof(T) == sizeof(double) ? DBL_EPSILON : FLT_EPSILON;
+  int numberOfLessWeights = 0;
+  while (numberOfLessWeights < numberOfWeights && lessWeight > 0.0 &&
+         weights[numberOfLessWeights] - epsilon <= weightBefore + lessWeight) {
+    numberOfLessWeights++;
+  }
+  int numberOfEqualWeights = numberOfLessWeights;
+  while (numberOfEqualWeights < numberOfWeights &&
+         ((equalWeight > 0.0 && weights[numberOfEqualWeights] - epsilon <=
+                                    weightBefore + lessWeight + equalWeight) ||
+          greaterStart == end)) {
+    numberOfEqualWeights++;
+  }
+  positionsAtCumulatedWeightsInRange(
+      permutation, lessEnd, greaterStart, weightBefore + lessWeight,
+      weights + numberOfLessWeights, numberOfEqualWeights - numberOfLessWeights,
+      positions + numberOfLessWeights,
+      cumulatedWeights + numberOfLessWeights);
+  return selectPositionsAtCumulatedWeights(
+             permutation, start, lessEnd, weightBefore, weights,
+             numberOfLessWeights, positions, cumulatedWeights, maxDepth - 1) &&
+         selectPositionsAtCumulatedWeights(
+             permutation, greaterStart, end,
+             weightBefore + lessWeight + equalWeight,
+             weights + numberOfEqualWeights,
+             numberOfWeights - numberOfEqualWeights,
+             positions + numberOfEqualWeights,
+             cumulatedWeights + numberOfEqualWeights, maxDepth - 1);
+}
+
+template <typename T>
+void StatisticsDataset<T>::positionsAtCumulatedWeightsInRange(
+    FloatList<float> *permutation, int start, int end, T weightBefore,
+    const T *weights, int numberOfWeights, int *positions,
+    T *cumulatedWeights) const {
+  // Elements in [start, end) are sorted
+  T epsilon = sizeof(T) == sizeof(double) ? DBL_EPSILON : FLT_EPSILON;
+  T cumulatedWeight = weightBefore;
+  int w = 0;
+  for (int i = start; i < end && w < numberOfWeights; i++) {
+    T elementWeight =
+        weightAtIndex(static_cast<int>(permutation->valueAtIndex(i)));
+    if (elementWeight == static_cast<T>(0.0)) {
+      continue;
+    }
+    cumulatedWeight += elementWeight;
+    while (w < numberOfWeights && cumulatedWeight >= weights[w] - epsilon) {
+      positions[w] = i;
+      cumulatedWeights[w++] = cumulatedWeight;
+    }
+  }
+  for (; w < numberOfWeights; w++) {
+    positions[w] = end - 1;
+    cumulatedWeights[w] = cumulatedWeight;
   }
-  return indexAtSortedIndex(elementSortedIndex);
 }
 
 template <typename T>
@@ -288,6 +288,9 @@ TreeHandle TreeHandle::BuildWithGhostChildren(TreeNode *node) {
    * nodes that have a fixed, non-zero number of children. */
   uint16_t nodeIdentifier = pool->generateIdentifier();
   node->rename(nodeIdentifier, false, true);
+#if POINCARE_TREE_STATS
+  pool->recordBuild(node);
+#endif
   for (int i = 0; i < expectedNumberOfChildren; i++) {
     GhostNode *ghost = new (pool->alloc(sizeof(GhostNode))) GhostNode();
     ghost->rename(pool->generateIdentifier(), false);
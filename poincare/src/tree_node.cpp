@@ -1,6 +1,7 @@
 #include <poincare/tree_handle.h>
 #include <poincare/tree_node.h>
 #include <poincare/tree_pool.h>
+#include <string.h>
 
 namespace Poincare {
 
@@ -211,6 +212,21 @@ size_t TreeNode::deepSize(int realNumberOfChildren) const {
          reinterpret_cast<const char *>(this);
 }
 
+size_t TreeNode::copyContent(uint8_t *buffer, size_t bufferSize) const {
+  // The vtable pointer and the bytes following the header
+  const uint8_t *header = reinterpret_cast<const uint8_t *>(this);
+  size_t headerSize = reinterpret_cast<const uint8_t *>(&m_identifier) - header;
+  const uint8_t *content =
+      reinterpret_cast<const uint8_t *>(&m_referenceCounter + 1);
+  size_t contentSize = header + size() - content;
+  if (headerSize + contentSize > bufferSize) {
+    return 0;
+  }
+  memcpy(buffer, header, headerSize);
+  memcpy(buffer + headerSize, content, contentSize);
+  return headerSize + contentSize;
+}
+
 bool TreeNode::deepIsGhost() const {
   if (isGhost()) {
     return true;
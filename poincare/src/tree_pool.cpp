@@ -5,6 +5,9 @@
 #include <poincare/tree_pool.h>
 #include <stdint.h>
 #include <string.h>
+#if POINCARE_TREE_STATS
+#include <sstream>
+#endif
 
 namespace Poincare {
 
@@ -68,8 +71,34 @@ TreeNode *TreePool::copyTreeFromAddress(const void *address, size_t size) {
 
 void TreePool::removeChildrenAndDestroy(TreeNode *nodeToDestroy,
                                         int nodeNumberOfChildren) {
-  removeChildren(nodeToDestroy, nodeNumberOfChildren);
-  discardTreeNode(nodeToDestroy);
+  size_t size = nodeToDestroy->deepSize(nodeNumberOfChildren);
+  TreeNode *end = reinterpret_cast<TreeNode *>(
+      reinterpret_cast<char *>(nodeToDestroy) + size);
+  /* Descendants only retained by their parent would be destroyed one after
+   * the other by removeChildren, each of them being first moved to the end of
+   * the pool. Discard them all at once instead. */
+  bool descendantsAreOnlyRetainedByParent = true;
+  for (TreeNode *node = nodeToDestroy->next(); node < end;
+       node = node->next()) {
+    if (node->retainCount() != 1) {
+      descendantsAreOnlyRetainedByParent = false;
+      break;
+    }
+  }
+  if (!descendantsAreOnlyRetainedByParent) {
+    removeChildren(nodeToDestroy, nodeNumberOfChildren);
+    discardTreeNode(nodeToDestroy);
+    return;
+  }
+  TreeNode *node = nodeToDestroy;
+  while (node < end) {
+    TreeNode *next = node->next();
+    uint16_t nodeIdentifier = node->identifier();
+    node->~TreeNode();
+    freeIdentifier(nodeIdentifier);
+    node = next;
+  }
+  dealloc(nodeToDestroy, size);
 }
 
 void TreePool::moveNodes(TreeNode *destination, TreeNode *source,
@@ -88,6 +117,11 @@ void TreePool::moveNodes(TreeNode *destination, TreeNode *source,
   uint32_t *dst = reinterpret_cast<uint32_t *>(destination);
   size_t len = moveSize / 4;
 
+#if POINCARE_TREE_STATS
+  m_statistics.numberOfMoves++;
+  m_statistics.movedBytes += moveSize;
+#endif
+
   if (Helpers::Rotate(dst, src, len)) {
     updateNodeForIdentifierFromNode(dst < src ? destination : source);
   }
@@ -117,6 +151,38 @@ void TreePool::treeLog(std::ostream &stream, bool verbose) {
 
 #endif
 
+#if POINCARE_TREE_STATS
+void TreePool::resetStatistics() {
+  m_statistics = Statistics();
+  m_statistics.peakNumberOfIdentifiers = numberOfUsedIdentifiers();
+}
+
+void TreePool::recordBuild(const TreeNode *node) {
+  const void *vtable = *reinterpret_cast<const void *const *>(node);
+  size_t size = Helpers::AlignedSize(node->size(), ByteAlignment);
+  int i = 0;
+  while (i < m_statistics.numberOfNodeTypes &&
+         m_statistics.nodeTypes[i].vtable != vtable) {
+    i++;
+  }
+  if (i == Statistics::k_maxNumberOfNodeTypes) {
+    m_statistics.numberOfUntypedBuilds++;
+    return;
+  }
+  Statistics::NodeType *type = m_statistics.nodeTypes + i;
+  if (i == m_statistics.numberOfNodeTypes) {
+    m_statistics.numberOfNodeTypes++;
+    std::ostringstream name;
+    node->logNodeName(name);
+    *type = Statistics::NodeType();
+    type->vtable = vtable;
+    strlcpy(type->name, name.str().c_str(), Statistics::k_nodeNameSize);
+  }
+  type->numberOfBuilds++;
+  type->builtBytes += size;
+}
+#endif
+
 int TreePool::numberOfNodes() const {
   int count = 0;
   TreeNode *firstNode = first();
@@ -136,10 +202,20 @@ void *TreePool::alloc(size_t size) {
 
   size = Helpers::AlignedSize(size, ByteAlignment);
   if (m_cursor + size > buffer() + BufferSize) {
+#if POINCARE_TREE_STATS
+    m_statistics.numberOfPoolFullExceptions++;
+#endif
     ExceptionCheckpoint::Raise();
   }
+#if POINCARE_TREE_STATS
+  m_statistics.numberOfAllocations++;
+  m_statistics.allocatedBytes += size;
+#endif
   void *result = m_cursor;
   m_cursor += size;
+  if (m_cursor > m_highWaterMark) {
+    m_highWaterMark = m_cursor;
+  }
   return result;
 }
 
@@ -155,6 +231,9 @@ void TreePool::dealloc(TreeNode *node, size_t size) {
 
   // Step 1 - Compact the pool
   memmove(ptr, ptr + size, m_cursor - (ptr + size));
+#if POINCARE_TREE_STATS
+  m_statistics.compactedBytes += m_cursor - (ptr + size);
+#endif
   m_cursor -= size;
 
   // Step 2: Update m_nodeForIdentifierOffset for all nodes downstream
@@ -2075,6 +2075,11 @@ QUIZ_CASE(poincare_approximation_lists_functions) {
       "samplestddev({1,2,3,4,5,6},{6,2,3,4,5,1})", 1.7113069358158486);
   assert_expression_approximates_to<double>("samplestddev({1})",
                                             Undefined::Name());
+  // Sums are compensated and the variance does not suffer from cancellation
+  assert_expression_approximates_to_scalar<double>("mean({10^16,1,-10^16})",
+                                                   1. / 3.);
+  assert_expression_approximates_to_scalar<double>(
+      "var({10^9+1,10^9+2,10^9+3})", 2. / 3.);
   assert_expression_approximates_to_scalar<double>("dim({1,2,3})", 3.);
   assert_expression_approximates_to_scalar<double>("min({1,2,3})", 1.);
   // undef is never the min (unless there are only undef in the list)
@@ -0,0 +1,67 @@
+#include <apps/shared/global_context.h>
+#include <poincare/approximation_cache.h>
+
+#include "helper.h"
+
+using namespace Poincare;
+
+QUIZ_CASE(poincare_approximation_cache_hits) {
+  Shared::GlobalContext globalContext;
+  ApproximationCache* cache = ApproximationCache::SharedCache();
+  cache->reset();
+  cache->resetCounters();
+  Expression e = parse_expression("x^2+cos(x)", &globalContext, false);
+  // The cache is skipped for a value of the symbol approximated first
+  double first = e.approximateWithValueForSymbol<double>("x", 2.0,
+                                                         &globalContext,
+                                                         Cartesian, Radian);
+  quiz_assert(cache->numberOfHits() == 0 && cache->numberOfMisses() == 0);
+  double second = e.approximateWithValueForSymbol<double>("x", 2.0,
+                                                          &globalContext,
+                                                          Cartesian, Radian);
+  quiz_assert(cache->numberOfHits() == 0 && cache->numberOfMisses() == 1);
+  double third = e.approximateWithValueForSymbol<double>("x", 2.0,
+                                                         &globalContext,
+                                                         Cartesian, Radian);
+  quiz_assert(cache->numberOfHits() == 1 && first == second &&
+              first == third);
+  // A copy of the tree shares its entry
+  Expression copy = e.clone();
+  copy.approximateWithValueForSymbol<double>("x", 2.0, &globalContext,
+                                             Cartesian, Radian);
+  quiz_assert(cache->numberOfHits() == 2);
+  // Any change of argument is a miss
+  double other = e.approximateWithValueForSymbol<double>(
+      "x", 3.0, &globalContext, Cartesian, Radian);
+  quiz_assert(cache->numberOfMisses() == 1 && other != first);
+  e.approximateWithValueForSymbol<double>("x", 2.0, &globalContext, Cartesian,
+                                          Degree);
+  e.approximateWithValueForSymbol<float>("x", 2.0f, &globalContext, Cartesian,
+                                         Radian);
+  // A tree of the same size is told apart from its content
+  parse_expression("x^2+sin(x)", &globalContext, false)
+      .approximateWithValueForSymbol<double>("x", 2.0, &globalContext,
+                                             Cartesian, Radian);
+  quiz_assert(cache->numberOfHits() == 2 && cache->numberOfMisses() == 4);
+  cache->reset();
+}
+
+QUIZ_CASE(poincare_approximation_cache_uncacheable) {
+  Shared::GlobalContext globalContext;
+  ApproximationCache* cache = ApproximationCache::SharedCache();
+  cache->reset();
+  cache->resetCounters();
+  // Trees too large to be copied in a key are not cached either
+  const char* expressions[] = {
+      "random()", "a+1", "x+y", "f(2)", "sum(k,k,1,3)",
+      "x+2x+3x+4x+5x+6x+7x+8x+9x+10x+11x+12x+13x+14x+15x+16x+17x+18x+19x"};
+  for (const char* expression : expressions) {
+    Expression e = parse_expression(expression, &globalContext, false);
+    for (int i = 0; i < 2; i++) {
+      e.approximateWithValueForSymbol<double>("x", 1.0, &globalContext,
+                                              Cartesian, Radian);
+      e.approximateToScalar<double>(&globalContext, Cartesian, Radian);
+    }
+  }
+  quiz_assert(cache->numberOfHits() == 0 && cache->numberOfMisses() == 0);
+}
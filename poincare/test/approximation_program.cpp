@@ -0,0 +1,93 @@
+#include <apps/shared/global_context.h>
+#include <poincare/approximation_program.h>
+
+#include "helper.h"
+
+using namespace Poincare;
+
+template <typename T>
+void assert_program_approximates_like_tree(
+    const char* expression, Preferences::AngleUnit angleUnit = Radian) {
+  Shared::GlobalContext globalContext;
+  Expression e = parse_expression(expression, &globalContext, false)
+                     .cloneAndReduce(ReductionContext(
+                         &globalContext, Real, angleUnit, MetricUnitFormat,
+                         SystemForApproximation));
+  ApproximationProgram<T> program;
+  quiz_assert_print_if_failure(
+      program.compile(e, "x", &globalContext, Real, angleUnit), expression);
+  for (int i = -40; i <= 40; i++) {
+    T x = static_cast<T>(i) / static_cast<T>(4.0);
+    T expected = e.approximateWithValueForSymbol<T>("x", x, &globalContext,
+                                                    Real, angleUnit);
+    quiz_assert_print_if_failure(
+        roughly_equal<T>(program.evaluate(x), expected,
+                         Float<T>::EpsilonLax(), true),
+        expression);
+  }
+}
+
+QUIZ_CASE(poincare_approximation_program) {
+  const char* expressions[] = {"x^2-3x+1",
+                               "1/x",
+                               "2^x",
+                               "√(x)",
+                               "x^(1/3)",
+                               "x^(2/3)+x^(3/5)",
+                               "x^0.5",
+                               "(x-1)^(-2)",
+                               "ln(x)",
+                               "log(x)",
+                               "abs(x-2)",
+                               "sin(x)+cos(2x)",
+                               "tan(x)",
+                               "e^(-x^2)",
+                               "x/x",
+                               "ln(x)+√(-x)"};
+  for (const char* expression : expressions) {
+    assert_program_approximates_like_tree<float>(expression);
+    assert_program_approximates_like_tree<double>(expression);
+  }
+  assert_program_approximates_like_tree<double>("sin(x)+tan(45x)", Degree);
+  assert_program_approximates_like_tree<float>("cos(100x)", Gradian);
+}
+
+QUIZ_CASE(poincare_approximation_program_fallback) {
+  Shared::GlobalContext globalContext;
+  ApproximationProgram<float> program;
+  const char* expressions[] = {"random()*x", "x+y", "f(x)", "floor(x)",
+                               "sum(k*x,k,1,3)"};
+  for (const char* expression : expressions) {
+    Expression e = parse_expression(expression, &globalContext, false);
+    quiz_assert_print_if_failure(
+        !program.compile(e, "x", &globalContext, Real, Radian), expression);
+    quiz_assert(program.isEmpty());
+  }
+  Expression e = parse_expression("x^2", &globalContext, false);
+  quiz_assert(!program.compile(e, "x", &globalContext, Cartesian, Radian));
+}
+
+QUIZ_CASE(poincare_approximation_program_batch) {
+  Shared::GlobalContext globalContext;
+  constexpr int n = 3 * ApproximationProgram<float>::k_batchSize + 5;
+  float x[n];
+  float y[n];
+  for (int i = 0; i < n; i++) {
+    x[i] = static_cast<float>(i - n / 2) / 4.0f;
+  }
+  // The second expression cannot be compiled and is approximated point-wise
+  const char* expressions[] = {"√(x)+sin(x)/x", "floor(x)*x"};
+  for (const char* expression : expressions) {
+    Expression e = parse_expression(expression, &globalContext, false);
+    e.approximateWithValuesForSymbol<float>("x", x, y, n, &globalContext, Real,
+                                            Radian);
+    for (int i = 0; i < n; i++) {
+      float expected = e.approximateWithValueForSymbol<float>(
+          "x", x[i], &globalContext, Real, Radian);
+      quiz_assert_print_if_failure(
+          roughly_equal<float>(y[i], expected, Float<float>::EpsilonLax(),
+                               true),
+          expression);
+    }
+  }
+}
@@ -1,5 +1,10 @@
+#include <float.h>
+#include <poincare/binomial_distribution.h>
 #include <poincare/chi2_distribution.h>
+#include <poincare/geometric_distribution.h>
+#include <poincare/hypergeometric_distribution.h>
 #include <poincare/normal_distribution.h>
+#include <poincare/poisson_distribution.h>
 #include <poincare/student_distribution.h>
 
 #include <algorithm>
@@ -376,3 +381,81 @@ QUIZ_CASE(poincare_normal_distribution_find_parameters) {
                                                                  0.5, 1., true),
       1., 1.e-3, false);
 }
+
+static double evaluateDistribution(double x, const void *auxiliary) {
+  const void *const *pack = static_cast<const void *const *>(auxiliary);
+  const Distribution *distribution = static_cast<const Distribution *>(pack[0]);
+  return distribution->evaluateAtAbscissa(x,
+                                         static_cast<const double *>(pack[1]));
+}
+
+static void assert_cumulative_function_matches_summation(
+    Distribution::Type type, const double *parameters, int maxAbscissa) {
+  const DiscreteDistribution *distribution =
+      static_cast<const DiscreteDistribution *>(Distribution::Get(type));
+  const void *pack[2] = {distribution, parameters};
+  for (int k = -1; k <= maxAbscissa; k++) {
+    double cumulative = distribution->cumulativeDistributiveFunctionAtAbscissa(
+        static_cast<double>(k), parameters);
+    // The template method sums the probability density function
+    double summedCumulative =
+        distribution->CumulativeDistributiveFunctionAtAbscissa<double>(
+            static_cast<double>(k), parameters);
+    // Subnormal probabilities are not precise
+    quiz_assert((cumulative < DBL_MIN && summedCumulative < DBL_MIN) ||
+                roughly_equal(cumulative, summedCumulative, 1e-6));
+  }
+  constexpr double probabilities[] = {0.001, 0.01, 0.1, 0.3, 0.5,
+                                      0.7,   0.9,  0.99, 0.999};
+  for (double probability : probabilities) {
+    double summedProbability = probability;
+    assert_roughly_equal<double>(
+        distribution->cumulativeDistributiveInverseForProbability(probability,
+                                                                  parameters),
+        SolverAlgorithms::CumulativeDistributiveInverseForNDefinedFunction<
+            double>(&summedProbability, evaluateDistribution, pack));
+  }
+}
+
+QUIZ_CASE(poincare_discrete_distributions_cumulative_function) {
+  constexpr double binomialParameters[][2] = {
+      {20., 0.3}, {150., 0.9}, {1000., 0.01}};
+  for (const double *parameters : binomialParameters) {
+    assert_cumulative_function_matches_summation(Distribution::Type::Binomial,
+                                                 parameters, 200);
+  }
+  constexpr double poissonParameters[][1] = {{0.5}, {4.}, {100.}, {2000.}};
+  for (const double *parameters : poissonParameters) {
+    assert_cumulative_function_matches_summation(Distribution::Type::Poisson,
+                                                 parameters, 2200);
+  }
+  constexpr double geometricParameters[][1] = {{0.05}, {0.5}, {1.}};
+  for (const double *parameters : geometricParameters) {
+    assert_cumulative_function_matches_summation(Distribution::Type::Geometric,
+                                                 parameters, 300);
+  }
+  constexpr double hypergeometricParameters[][3] = {
+      {42., 24., 34.}, {40., 20., 30.}, {500., 200., 100.}};
+  for (const double *parameters : hypergeometricParameters) {
+    assert_cumulative_function_matches_summation(
+        Distribution::Type::Hypergeometric, parameters, 110);
+  }
+
+  // The summation used to be truncated after a million terms
+  assert_roughly_equal<double>(
+      PoissonDistribution::CumulativeDistributiveFunctionAtAbscissa<double>(
+          2e6, 2e6),
+      0.50018806, 1e-7);
+  assert_roughly_equal<double>(
+      PoissonDistribution::CumulativeDistributiveInverseForProbability<double>(
+          0.5, 2e6),
+      2e6);
+  assert_roughly_equal<double>(
+      BinomialDistribution::CumulativeDistributiveInverseForProbability<double>(
+          0.5, 1e6, 0.5),
+      5e5);
+  assert_roughly_equal<double>(
+      HypergeometricDistribution::CumulativeDistributiveFunctionAtAbscissa<
+          double>(5e4, 2e5, 1e5, 1e5),
+      0.50178412, 1e-7);
+}
@@ -109,3 +109,131 @@ QUIZ_CASE(poincare_helpers_rotate) {
     }
   }
 }
+
+struct SortContext {
+  int* values;
+  int numberOfComparisons;
+  bool lenient;
+};
+
+static void assert_sort_is_correct(int* values, int length, int maxValue) {
+  int* copy = new int[length];
+  for (int i = 0; i < length; i++) {
+    copy[i] = values[i];
+  }
+  SortContext context = {values, 0, length % 2 == 0};
+  Poincare::Helpers::Sort(
+      [](int i, int j, void* ctx, int n) {
+        int* values = reinterpret_cast<SortContext*>(ctx)->values;
+        int temp = values[i];
+        values[i] = values[j];
+        values[j] = temp;
+      },
+      [](int i, int j, void* ctx, int n) {
+        SortContext* context = reinterpret_cast<SortContext*>(ctx);
+        context->numberOfComparisons++;
+        return context->lenient ? context->values[i] >= context->values[j]
+                                : context->values[i] > context->values[j];
+      },
+      &context, length);
+  // The comparisons are O(n log(n)) whatever the order of the values
+  int log = 1;
+  for (int n = length; n > 1; n /= 2) {
+    log++;
+  }
+  quiz_assert(context.numberOfComparisons <= 4 * length * log);
+  // The result is sorted and has the same values
+  for (int i = 1; i < length; i++) {
+    quiz_assert(values[i - 1] <= values[i]);
+  }
+  for (int v = 0; v <= maxValue; v++) {
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+      count += (values[i] == v) - (copy[i] == v);
+    }
+    quiz_assert(count == 0);
+  }
+  delete[] copy;
+}
+
+QUIZ_CASE(poincare_helpers_sort) {
+  constexpr int k_maxLength = 1000;
+  int values[k_maxLength];
+  constexpr int lengths[] = {0, 1, 2, 3, 16, 17, 100, 255, k_maxLength};
+  uint32_t seed = 1;
+  for (int length : lengths) {
+    constexpr int k_numberOfPatterns = 6;
+    for (int pattern = 0; pattern < k_numberOfPatterns; pattern++) {
+      int maxValue = length;
+      for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        int random = (seed >> 16) % (length + 1);
+        switch (pattern) {
+          case 0:  // Random
+            values[i] = random;
+            break;
+          case 1:  // Sorted
+            values[i] = i;
+            break;
+          case 2:  // Reversed
+            values[i] = length - i;
+            break;
+          case 3:  // Equal
+            values[i] = 7;
+            maxValue = 7;
+            break;
+          case 4:  // Few distinct values
+            values[i] = random % 3;
+            break;
+          default:  // Sorted with a few random values
+            values[i] = i % 10 == 0 ? random : i;
+        }
+      }
+      assert_sort_is_correct(values, length, maxValue);
+    }
+  }
+}
+
+struct Pair {
+  int key;
+  int index;
+};
+
+static void assert_sort_keeps_order_of_equal_keys(bool lenient) {
+  constexpr int k_length = 255;
+  Pair pairs[k_length];
+  uint32_t seed = 1;
+  for (int i = 0; i < k_length; i++) {
+    seed = seed * 1103515245 + 12345;
+    pairs[i] = {static_cast<int>((seed >> 16) % 5), i};
+  }
+  void* pack[] = {pairs, &lenient};
+  Poincare::Helpers::Sort(
+      [](int i, int j, void* ctx, int n) {
+        Pair* pairs = reinterpret_cast<Pair*>(reinterpret_cast<void**>(ctx)[0]);
+        Pair temp = pairs[i];
+        pairs[i] = pairs[j];
+        pairs[j] = temp;
+      },
+      [](int i, int j, void* ctx, int n) {
+        void** pack = reinterpret_cast<void**>(ctx);
+        Pair* pairs = reinterpret_cast<Pair*>(pack[0]);
+        bool lenient = *reinterpret_cast<bool*>(pack[1]);
+        return lenient ? pairs[i].key >= pairs[j].key
+                       : pairs[i].key > pairs[j].key;
+      },
+      pack, k_length);
+  /* Equal keys keep their order with a lenient comparison, and are reversed
+   * with a strict one. */
+  for (int i = 1; i < k_length; i++) {
+    quiz_assert(pairs[i - 1].key <= pairs[i].key);
+    if (pairs[i - 1].key == pairs[i].key) {
+      quiz_assert((pairs[i - 1].index < pairs[i].index) == lenient);
+    }
+  }
+}
+
+QUIZ_CASE(poincare_helpers_sort_keeps_order) {
+  assert_sort_keeps_order_of_equal_keys(true);
+  assert_sort_keeps_order_of_equal_keys(false);
+}
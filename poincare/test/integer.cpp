@@ -1,6 +1,7 @@
 #include <poincare/expression.h>
 #include <poincare/infinity.h>
 #include <poincare/integer.h>
+#include <poincare/undefined.h>
 
 #include "helper.h"
 
@@ -86,6 +87,17 @@ QUIZ_CASE(poincare_integer_properties) {
   quiz_assert(!Integer(2).isNegative());
   quiz_assert(Integer(-2).isNegative());
   quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(MaxInteger()) == 309);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer(0)) == 1);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer(-7)) == 1);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer(999999999)) ==
+              9);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer(1000000000)) ==
+              10);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(
+                  Integer("999999999999999999")) == 18);
+  // Integers with the same number of digits do not share their count
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(
+                  Integer("1000000000000000000")) == 19);
 }
 
 static inline void assert_add_to(const Integer i, const Integer j,
@@ -189,6 +201,68 @@ QUIZ_CASE(poincare_integer_multiplication) {
                  Integer("2371623107781647520"));
   assert_mult_to(Integer("389282362616"), Integer(720),
                  Integer("280283301083520"));
+
+  // Large operands: balanced, unbalanced, carry-heavy and overflowing cases
+  assert_mult_to(
+      Integer("1980108470485074474245613967775518006523564954857708593725214531"
+              "3061125976497076905393997211219820243974788906234676656719831891"
+              "5847057685525560"),
+      Integer("9242811648025407501107089050997097556005089921614412222764426795"
+              "4689697556739369277130309903820766584428213798421459847371372281"
+              "238463343654348"),
+      Integer("1830176963535322016886084273143208537223347334889658883077058960"
+              "9798495669838008905333616131183183035764837235937827331567491265"
+              "1262934924113525196183990535241681810627848797352812282588510439"
+              "7558174775555614367230489255096579522121104677954061304938545277"
+              "4367638539353318251955359134880"));
+  assert_mult_to(
+      Integer("4355533764404754078586634145408711972017011655180736990961144089"
+              "019772507555400436224937177320864713670816342356057"),
+      Integer("6696487575917599718302287344335798295013942920507517559775981273"
+              "9744511356776105916719677211655674509171002124471407735547332144"
+              "71374448164547397606089774536733170725764309414972096535910320"),
+      Integer("2916677773982604951345987263097744401111376921805792471897980020"
+              "6514566691171003863845214409681893990836432069304779884685662091"
+              "7428449464796752164145606131626997191158728052457125300440761638"
+              "7343610345176260568439297842369636679941539233285261189011086383"
+              "4879230228081187928981003568195112278736060808240"));
+  assert_mult_to(
+      Integer("1692303280103036413316903188563893861960715988388559921368700915"
+              "90247882556495704531248437872567112920983350278405979725889535"),
+      Integer("1692303280103036413316903188563893861960715988388559921368700915"
+              "90247882556495704531248437872567112920983350278405979725889535"),
+      Integer("2863890391847496120441878393367483849072173917217065252944144970"
+              "2311064005352904159345284265824628375429359509218999720074396522"
+              "2964173560931623626609268668417404821647815343902825275212957982"
+              "80479927016822682750600185419380895616914801975147022516225"));
+  assert_mult_to(
+      Integer("1340780792994259709957402499820584612747936582059239337772356144"
+              "3721764030073546976801874298166903427690031858186486050853753882"
+              "811946569946433649006084095"),
+      Integer("1340780792994259709957402499820584612747936582059239337772356144"
+              "3721764030073546976801874298166903427690031858186486050853753882"
+              "811946569946433649006084095"),
+      Integer("1797693134862315907729305190789024733617976978942306572734300811"
+              "5773267580550096313270847732240753602112011387987139335765878976"
+              "8814416622492847430639474097562152033539671286128252223189553839"
+              "1607214417672982503217152632388144027343799595067922309033564951"
+              "30620869925267845538430714092411695463462326211969025"));
+  // (2^(16*k_maxNumberOfDigits))^2 = (2^32)^k_maxNumberOfDigits
+  Integer halfOverflow =
+      Integer::Power(Integer(2), Integer(16 * Integer::k_maxNumberOfDigits));
+  quiz_assert(Integer::Multiplication(halfOverflow, halfOverflow).isOverflow());
+#if POINCARE_INTEGER_MAX_NUMBER_OF_DIGITS >= 64
+  // Operands of more than 24 digits are multiplied with Karatsuba's algorithm
+  Integer x = Integer::Subtraction(Integer::Power(Integer(3), Integer(570)),
+                                   Integer::Power(Integer(2), Integer(800)));
+  Integer xSquare = Integer::Power(x, Integer(2));
+  assert_mult_to(Integer::Addition(x, Integer(1)),
+                 Integer::Subtraction(x, Integer(1)),
+                 Integer::Subtraction(xSquare, Integer(1)));
+  Integer y = Integer::Power(Integer(7), Integer(300));
+  quiz_assert(Integer::NaturalOrder(Integer::Multiplication(x, y),
+                                    Integer::Multiplication(y, x)) == 0);
+#endif
 }
 
 static inline void assert_div_to(const Integer i, const Integer j,
@@ -380,6 +454,23 @@ QUIZ_CASE(poincare_integer_serialize) {
   assert_integer_serializes_to(Integer("-2345678909876"), "-2345678909876");
   assert_integer_serializes_to(MaxInteger(), MaxIntegerString());
   assert_integer_serializes_to(OverflowedInteger(), Infinity::Name());
+  // Chunks of 9 decimal digits containing zeros
+  assert_integer_serializes_to(Integer(0), "0");
+  assert_integer_serializes_to(Integer("1000000000"), "1000000000");
+  assert_integer_serializes_to(Integer("-1000000000000000000000000000"),
+                               "-1000000000000000000000000000");
+  assert_integer_serializes_to(Integer("7000000000000000050000000001"),
+                               "7000000000000000050000000001");
+  assert_integer_serializes_to(Integer::Power(Integer(10), Integer(100)),
+                               "1000000000000000000000000000000000000000000000"
+                               "0000000000000000000000000000000000000000000000"
+                               "000000000");
+  // Too small buffer
+  char buffer[6];
+  Integer("123456").serialize(buffer, 6);
+  quiz_assert(strcmp(buffer, Undefined::Name()) == 0);
+  Integer("-1234").serialize(buffer, 6);
+  quiz_assert(strcmp(buffer, "-1234") == 0);
 }
 
 // Euclidian Division
@@ -0,0 +1,108 @@
+#include <poincare/statistics_dataset.h>
+
+#include "helper.h"
+
+using namespace Poincare;
+
+class ArrayColumn : public DatasetColumn<double> {
+ public:
+  ArrayColumn(const double* values, int length)
+      : m_values(values), m_length(length) {}
+  double valueAtIndex(int index) const override { return m_values[index]; }
+  int length() const override { return m_length; }
+
+ private:
+  const double* m_values;
+  int m_length;
+};
+
+/* Compare the elements selected by a fresh dataset with the elements found in
+ * the sorted index of a memoized dataset. */
+static void assert_selected_elements_are_sorted_elements(
+    const double* values, const double* weights, int length,
+    const double* cumulatedWeights, int numberOfCumulatedWeights) {
+  ArrayColumn valuesColumn(values, length);
+  ArrayColumn weightsColumn(weights, length);
+  StatisticsDataset<double> selected(&valuesColumn, &weightsColumn);
+  StatisticsDataset<double> sorted(&valuesColumn, &weightsColumn);
+  sorted.setIsMemoized();
+  double selectedElements[StatisticsDataset<double>::
+                              k_maxNumberOfCumulatedWeights];
+  double sortedElements[StatisticsDataset<double>::
+                            k_maxNumberOfCumulatedWeights];
+  selected.sortedElementsAtCumulatedWeights(
+      cumulatedWeights, numberOfCumulatedWeights, true, selectedElements);
+  sorted.sortedElementsAtCumulatedWeights(
+      cumulatedWeights, numberOfCumulatedWeights, true, sortedElements);
+  for (int i = 0; i < numberOfCumulatedWeights; i++) {
+    quiz_assert(selectedElements[i] == sortedElements[i]);
+  }
+}
+
+QUIZ_CASE(poincare_statistics_dataset_selection) {
+  constexpr int k_length = 200;
+  double values[k_length];
+  double weights[k_length];
+  double cumulatedWeights[StatisticsDataset<double>::
+                              k_maxNumberOfCumulatedWeights];
+  uint32_t seed = 1;
+  for (int test = 0; test < 40; test++) {
+    int length = test % 5 == 0 ? test / 5 + 1 : k_length - test;
+    double totalWeight = 0.0;
+    for (int i = 0; i < length; i++) {
+      seed = seed * 1103515245 + 12345;
+      // Few distinct values to have ties, some null weights
+      values[i] = test % 2 == 0 ? (seed >> 16) % 10 : (seed >> 8) % 1000;
+      weights[i] = (seed >> 20) % 4;
+      totalWeight += weights[i];
+    }
+    // Deciles, quartiles and median, plus weights out of the dataset
+    for (int i = 0; i < StatisticsDataset<double>::k_maxNumberOfCumulatedWeights;
+         i++) {
+      cumulatedWeights[i] = totalWeight * (i + 1) / 10.0;
+    }
+    assert_selected_elements_are_sorted_elements(
+        values, weights, length, cumulatedWeights,
+        StatisticsDataset<double>::k_maxNumberOfCumulatedWeights);
+    double quartiles[] = {0.0, totalWeight / 4.0, totalWeight / 2.0,
+                          3.0 * totalWeight / 4.0, totalWeight + 1.0};
+    assert_selected_elements_are_sorted_elements(values, weights, length,
+                                                 quartiles, 5);
+  }
+
+  // Sorted, reversed and constant datasets
+  for (int i = 0; i < k_length; i++) {
+    values[i] = i;
+    weights[i] = 1.0;
+  }
+  double median = k_length / 2.0;
+  assert_selected_elements_are_sorted_elements(values, weights, k_length,
+                                               &median, 1);
+  for (int i = 0; i < k_length; i++) {
+    values[i] = k_length - i;
+  }
+  assert_selected_elements_are_sorted_elements(values, weights, k_length,
+                                               &median, 1);
+  for (int i = 0; i < k_length; i++) {
+    values[i] = 1.0;
+  }
+  assert_selected_elements_are_sorted_elements(values, weights, k_length,
+                                               &median, 1);
+
+  // Only the first requested elements are selected
+  for (int i = 0; i < k_length; i++) {
+    values[i] = (i * 37) % k_length;
+  }
+  ArrayColumn valuesColumn(values, k_length);
+  StatisticsDataset<double> dataset(&valuesColumn);
+  quiz_assert(dataset.median() == (k_length - 1) / 2.0);
+  quiz_assert(dataset.sortedElementAtCumulatedFrequency(1.0 / 4.0, false) ==
+              k_length / 4 - 1);
+  double frequencies[] = {0.1, 0.5, 0.9};
+  double deciles[3];
+  dataset.setHasBeenModified();
+  dataset.sortedElementsAtCumulatedFrequencies(frequencies, 3, false, deciles);
+  quiz_assert(deciles[0] == k_length / 10 - 1 &&
+              deciles[1] == k_length / 2 - 1 &&
+              deciles[2] == 9 * k_length / 10 - 1);
+}
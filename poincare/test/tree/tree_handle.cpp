@@ -94,3 +94,25 @@ QUIZ_CASE(tree_handle_does_not_copy) {
   PairByReference p2 = p;
   assert_pool_size(initialPoolSize + 3);
 }
+
+QUIZ_CASE(tree_handle_discards_whole_trees) {
+  int initialPoolSize = pool_size();
+  BlobByReference b = BlobByReference::Builder(4);
+  {
+    PairByReference p = PairByReference::Builder(
+        PairByReference::Builder(BlobByReference::Builder(1),
+                                 BlobByReference::Builder(2)),
+        BlobByReference::Builder(3));
+    assert_pool_size(initialPoolSize + 6);
+  }
+  assert_pool_size(initialPoolSize + 1);
+  {
+    // A descendant still referenced elsewhere outlives the tree
+    PairByReference p = PairByReference::Builder(
+        PairByReference::Builder(BlobByReference::Builder(1), b),
+        BlobByReference::Builder(3));
+    assert_pool_size(initialPoolSize + 5);
+  }
+  assert_pool_size(initialPoolSize + 1);
+  quiz_assert(b.data() == 4 && b.parent().isUninitialized());
+}